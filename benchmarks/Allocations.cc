@@ -0,0 +1,77 @@
+// Replaces the global allocation functions to count allocations.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "Benchmark.h"
+
+namespace {
+
+std::atomic_size_t count = 0;
+
+void *allocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+{
+  const auto align = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+  return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+  // The size must be a multiple of the alignment.
+  return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+}
+
+void freeAligned(void *ptr) noexcept
+{
+#ifdef _MSC_VER
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+} // namespace
+
+std::size_t bench::allocations() noexcept
+{
+  return count.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size)
+{
+  count.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size == 0 ? 1 : size); ptr) {
+    return ptr;
+  }
+  std::abort();
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*unused*/) noexcept
+{
+  std::free(ptr);
+}
+
+// Over-aligned types and std::pmr::new_delete_resource() use the aligned allocation functions.
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+  count.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = allocateAligned(size, alignment); ptr) {
+    return ptr;
+  }
+  std::abort();
+}
+
+void operator delete(void *ptr, std::align_val_t /*unused*/) noexcept
+{
+  freeAligned(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*unused*/, std::align_val_t /*unused*/) noexcept
+{
+  freeAligned(ptr);
+}
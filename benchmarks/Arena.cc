@@ -0,0 +1,100 @@
+// Measures setting up and tearing down signals once per frame, with every allocation made on the
+// global heap by a default signal and from a monotonic arena that is released as a whole by a
+// signal using a memory resource. Epoch signals are chained, so their emissions build dispatch
+// plans as well.
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+constexpr std::size_t signalCount = 16;
+constexpr std::size_t slotCount = 16;
+
+struct PmrEpochPolicy : sigs::PmrPolicy {
+  static constexpr sigs::Emission emission = sigs::Emission::Epoch;
+};
+
+/// Connects slots to \p s, half of which are too large to be stored inline, and emits it. One slot
+/// disconnects itself while being emitted, which defers the modification with locked emission.
+template <typename Signal>
+void setUp(Signal &s, int &sum)
+{
+  std::array<int, 16> weights{};
+  weights[0] = 1;
+  for (std::size_t i = 0; i < slotCount; ++i) {
+    if (i % 2 == 0) {
+      s.connect([&sum](int value) { sum += value; });
+    }
+    else {
+      s.connect([&sum, weights](int value) { sum += value * weights[0]; });
+    }
+  }
+
+  sigs::Connection conn;
+  conn = s.connect([&conn](int /*unused*/) { conn->disconnect(); });
+  s(1);
+}
+
+template <typename Frame>
+void run(const std::string &name, Frame &&frame)
+{
+  // Warms up the state kept per thread, like the record of the thread for epoch emission.
+  frame();
+
+  bench::report(name, "allocs/frame", bench::allocationsPerOp(frame));
+  bench::report(name, "ns/frame", bench::nsPerOp(frame));
+}
+
+} // namespace
+
+int main()
+{
+  int sum = 0;
+
+  run("sigs::Signal", [&sum] {
+    std::array<std::optional<sigs::Signal<void(int)>>, signalCount> signals;
+    for (auto &s : signals) {
+      setUp(s.emplace(), sum);
+    }
+  });
+
+  std::vector<std::byte> buffer(1 << 22);
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+  run("sigs::PmrSignal, monotonic arena", [&sum, &arena] {
+    {
+      std::array<std::optional<sigs::PmrSignal<void(int)>>, signalCount> signals;
+      for (auto &s : signals) {
+        setUp(s.emplace(&arena), sum);
+      }
+    }
+    arena.release();
+  });
+
+  run("epoch sigs::BasicSignal, monotonic arena", [&sum, &arena] {
+    {
+      using Signal = sigs::BasicSignal<void(int), sigs::BasicLock, PmrEpochPolicy>;
+      std::array<std::optional<Signal>, signalCount> signals;
+      for (std::size_t i = 0; i < signalCount; ++i) {
+        signals[i].emplace(&arena);
+        if (i > 0) {
+          signals[i - 1]->connect(*signals[i]);
+        }
+      }
+      for (auto &s : signals) {
+        setUp(*s, sum);
+      }
+    }
+    arena.release();
+  });
+
+  bench::doNotOptimize(sum);
+  return 0;
+}
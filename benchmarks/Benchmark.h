@@ -0,0 +1,253 @@
+// Minimal self-contained benchmark harness used by the benchmarks.
+
+#ifndef SIGS_BENCHMARK_H
+#define SIGS_BENCHMARK_H
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#ifdef __linux__
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifndef SIGS_BENCHMARK_NAME
+#define SIGS_BENCHMARK_NAME "unknown"
+#endif
+
+namespace bench {
+
+/// Number of global allocations made so far, counted by the replaced operator new.
+std::size_t allocations() noexcept;
+
+/// Prevents the compiler from optimizing away the computation of \p value.
+template <typename T>
+inline void doNotOptimize(T &value) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  static_cast<void>(*static_cast<volatile T *>(&value));
+#else
+  asm volatile("" : "+m"(value) : : "memory");
+#endif
+}
+
+/// Calls \p func, which performs \p ops operations per call, until at least \p minTime has elapsed
+/// and returns the average nanoseconds per operation of the fastest of three rounds.
+template <typename Func>
+double nsPerOp(Func &&func, std::size_t ops = 1,
+               std::chrono::nanoseconds minTime = std::chrono::milliseconds(100))
+{
+  using Clock = std::chrono::steady_clock;
+
+  // Warm up caches and find an iteration count that runs for long enough.
+  std::size_t iterations = 1;
+  for (;;) {
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+      func();
+    }
+    if (Clock::now() - start >= minTime / 10) break;
+    iterations *= 2;
+  }
+  iterations *= 10;
+
+  double best = 0;
+  for (int round = 0; round < 3; ++round) {
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+      func();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    const auto ns = elapsed.count() / static_cast<double>(iterations * ops);
+    if (round == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+/// Average number of allocations per operation made by calling \p func once.
+template <typename Func>
+double allocationsPerOp(Func &&func, std::size_t ops = 1)
+{
+  const auto before = allocations();
+  func();
+  return static_cast<double>(allocations() - before) / static_cast<double>(ops);
+}
+
+namespace detail {
+
+/// File named by the `SIGS_BENCHMARK_JSON` environment variable that results are appended to, or
+/// null if it isn't set.
+inline std::FILE *jsonFile() noexcept
+{
+  static std::FILE *const file = [] {
+    const char *path = std::getenv("SIGS_BENCHMARK_JSON");
+    return path != nullptr && *path != '\0' ? std::fopen(path, "a") : nullptr;
+  }();
+  return file;
+}
+
+/// Writes \p text as a quoted JSON string.
+inline void writeJsonString(std::FILE *file, const std::string &text) noexcept
+{
+  std::fputc('"', file);
+  for (const char ch : text) {
+    if (ch == '"' || ch == '\\') {
+      std::fputc('\\', file);
+      std::fputc(ch, file);
+    }
+    else if (static_cast<unsigned char>(ch) < 0x20) {
+      std::fprintf(file, "\\u%04x", static_cast<unsigned>(ch));
+    }
+    else {
+      std::fputc(ch, file);
+    }
+  }
+  std::fputc('"', file);
+}
+
+} // namespace detail
+
+/// Prints the \p value of \p metric measured for \p name.
+/** If the `SIGS_BENCHMARK_JSON` environment variable names a file, the result is also appended to
+    it as a JSON object on its own line, like
+    `{"benchmark": "layout", "name": "10 slots", "metric": "ns/emitted slot", "value": 1.25}`. */
+inline void report(const std::string &name, const std::string &metric, double value)
+{
+  std::printf("%-50s %-20s %12.3f\n", name.c_str(), metric.c_str(), value);
+
+  auto *file = detail::jsonFile();
+  if (file == nullptr) return;
+
+  std::fputs("{\"benchmark\": ", file);
+  detail::writeJsonString(file, SIGS_BENCHMARK_NAME);
+  std::fputs(", \"name\": ", file);
+  detail::writeJsonString(file, name);
+  std::fputs(", \"metric\": ", file);
+  detail::writeJsonString(file, metric);
+  if (std::isfinite(value)) {
+    std::fprintf(file, ", \"value\": %.17g}\n", value);
+  }
+  else {
+    std::fputs(", \"value\": null}\n", file);
+  }
+  std::fflush(file);
+}
+
+/// Hardware event counted by Counter.
+enum class Event { L1dMisses, LlcMisses, Instructions };
+
+/// Counts a hardware event of the calling thread in user space.
+/** Only available on Linux and only if perf events are permitted, otherwise valid() is false and
+    the benchmarks skip the metric. */
+class Counter {
+public:
+  explicit Counter(Event event) noexcept
+  {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    switch (event) {
+    case Event::L1dMisses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+
+    case Event::LlcMisses:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+
+    case Event::Instructions:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    }
+
+    fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+    static_cast<void>(event);
+#endif
+  }
+
+  ~Counter()
+  {
+#ifdef __linux__
+    if (valid()) {
+      close(fd);
+    }
+#endif
+  }
+
+  Counter(const Counter &rhs) = delete;
+  Counter &operator=(const Counter &rhs) = delete;
+
+  [[nodiscard]] bool valid() const noexcept
+  {
+    return fd >= 0;
+  }
+
+  /// Number of events counted while calling \p func once.
+  template <typename Func>
+  std::uint64_t measure(Func &&func) noexcept
+  {
+    std::uint64_t count = 0;
+#ifdef __linux__
+    if (valid()) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      func();
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+      }
+      return count;
+    }
+#endif
+    func();
+    return count;
+  }
+
+private:
+  int fd = -1;
+};
+
+/// Reports the average number of \p event per operation made by calling \p func, which performs
+/// \p ops operations per call, or nothing if the event can't be counted.
+template <typename Func>
+void reportEvent(const std::string &name, const std::string &metric, Event event, Func &&func,
+                 std::size_t ops = 1, std::size_t iterations = 100)
+{
+  Counter counter(event);
+  if (!counter.valid()) return;
+
+  // Warm up.
+  func();
+
+  const auto count = counter.measure([&] {
+    for (std::size_t i = 0; i < iterations; ++i) {
+      func();
+    }
+  });
+  report(name, metric, static_cast<double>(count) / static_cast<double>(iterations * ops));
+}
+
+} // namespace bench
+
+#endif // SIGS_BENCHMARK_H
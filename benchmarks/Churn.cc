@@ -0,0 +1,55 @@
+// Measures disconnecting a slot and connecting a new one on signals with many connections, which
+// is the steady state of signals with heavy churn.
+
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+void churn(std::size_t slotCount)
+{
+  sigs::Signal<void(int &)> s;
+  std::vector<sigs::Connection> conns;
+  for (std::size_t i = 0; i < slotCount; ++i) {
+    conns.emplace_back(s.connect([](int &sum) { sum++; }));
+  }
+
+  // Disconnects the connections from the oldest to the newest, so the erased entries are spread
+  // over the whole signal.
+  std::size_t next = 0;
+  auto reconnect = [&] {
+    auto &conn = conns[next];
+    conn->disconnect();
+    conn = s.connect([](int &sum) { sum++; });
+    next = (next + 1) % slotCount;
+  };
+
+  const auto name = std::to_string(slotCount) + " slots";
+
+  // Averaged over many reconnections, since growing the arrays allocates only now and then.
+  constexpr std::size_t reconnects = 1000;
+  auto reconnectMany = [&] {
+    for (std::size_t i = 0; i < reconnects; ++i) {
+      reconnect();
+    }
+  };
+  bench::report(name, "allocs/reconnect", bench::allocationsPerOp(reconnectMany, reconnects));
+  bench::report(name, "ns/reconnect", bench::nsPerOp(reconnect));
+
+  int sum = 0;
+  bench::report(name, "ns/slot emitted", bench::nsPerOp([&] { s(sum); }, slotCount));
+  bench::doNotOptimize(sum);
+}
+
+} // namespace
+
+int main()
+{
+  for (const std::size_t slotCount : {10, 1000, 50000}) {
+    churn(slotCount);
+  }
+  return 0;
+}
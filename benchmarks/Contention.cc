@@ -0,0 +1,75 @@
+// Measures several threads emitting the same signal concurrently, whose emissions are serialized
+// by a default signal but run in parallel with a shared signal.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+constexpr std::size_t slotCount = 8;
+constexpr std::size_t emissions = 20000;
+
+/// CPU-bound slot that doesn't touch any shared memory.
+void work(const unsigned &seed)
+{
+  unsigned value = seed;
+  for (int i = 0; i < 100; ++i) {
+    value = value * 1664525u + 1013904223u;
+  }
+  bench::doNotOptimize(value);
+}
+
+/// Average wall-clock nanoseconds per emission while \p threads threads emit \p s concurrently.
+template <typename Signal>
+double nsPerEmission(Signal &s, unsigned threads)
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> emitters;
+  for (unsigned t = 0; t < threads; ++t) {
+    emitters.emplace_back([&s] {
+      for (std::size_t i = 0; i < emissions; ++i) {
+        s(42);
+      }
+    });
+  }
+  for (auto &emitter : emitters) {
+    emitter.join();
+  }
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(emissions * threads);
+}
+
+template <typename Signal>
+void run(const std::string &name)
+{
+  Signal s;
+  for (std::size_t i = 0; i < slotCount; ++i) {
+    s.connect(work);
+  }
+
+  const auto cores = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= std::min(cores, 8u); threads *= 2) {
+    // Fastest of three rounds, like bench::nsPerOp().
+    double best = 0;
+    for (int round = 0; round < 3; ++round) {
+      const auto ns = nsPerEmission(s, threads);
+      best = round == 0 ? ns : std::min(best, ns);
+    }
+    bench::report(name + ", " + std::to_string(threads) + " threads", "ns/emission", best);
+  }
+}
+
+} // namespace
+
+int main()
+{
+  run<sigs::Signal<void(const unsigned &)>>("locked");
+  run<sigs::SharedSignal<void(const unsigned &)>>("shared");
+  return 0;
+}
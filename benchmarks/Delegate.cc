@@ -0,0 +1,173 @@
+// Compares sigs::Delegate, which stores slots of sigs::BasicSignal, with std::function.
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+constexpr std::size_t slotCount = 1000;
+
+/// Slot capturing 32 bytes, which is too large for the small buffer of std::function.
+auto makeSlot(int *a, int *b, int *c, int n)
+{
+  return [a, b, c, n](int &i) { i += *a + *b + *c + n; };
+}
+
+template <typename Func>
+void benchmarkInvoke(const std::string &name)
+{
+  int a = 1, b = 2, c = 3;
+  std::vector<Func> funcs;
+  funcs.reserve(slotCount);
+
+  const auto allocs = bench::allocationsPerOp(
+    [&] {
+      for (std::size_t n = 0; n < slotCount; ++n) {
+        funcs.emplace_back(makeSlot(&a, &b, &c, static_cast<int>(n)));
+      }
+    },
+    slotCount);
+  bench::report(name, "allocs/construct", allocs);
+
+  const auto ns = bench::nsPerOp(
+    [&] {
+      int i = 0;
+      for (const auto &func : funcs) {
+        func(i);
+      }
+      bench::doNotOptimize(i);
+    },
+    slotCount);
+  bench::report(name, "ns/invocation", ns);
+}
+
+void addOne(int &i)
+{
+  i++;
+}
+
+void benchmarkFunctions()
+{
+  std::vector<void (*)(int &)> funcs(slotCount, &addOne);
+  const auto rawNs = bench::nsPerOp(
+    [&] {
+      int i = 0;
+      for (const auto func : funcs) {
+        func(i);
+      }
+      bench::doNotOptimize(i);
+    },
+    slotCount);
+  bench::report("function pointer array", "ns/invocation", rawNs);
+
+  sigs::Signal<void(int &)> s;
+  sigs::Signal<void(int &)> erased;
+  for (std::size_t n = 0; n < slotCount; ++n) {
+    s.connect(&addOne);
+    erased.connect(sigs::Signal<void(int &)>::SlotType(&addOne));
+  }
+
+  const auto ns = bench::nsPerOp(
+    [&] {
+      int i = 0;
+      s(i);
+      bench::doNotOptimize(i);
+    },
+    slotCount);
+  bench::report("function slots (direct)", "ns/emitted slot", ns);
+
+  const auto erasedNs = bench::nsPerOp(
+    [&] {
+      int i = 0;
+      erased(i);
+      bench::doNotOptimize(i);
+    },
+    slotCount);
+  bench::report("function slots (delegate)", "ns/emitted slot", erasedNs);
+}
+
+class Receiver {
+public:
+  void receive(int &i)
+  {
+    i += value;
+  }
+
+  int value = 1;
+};
+
+template <typename Func>
+void benchmarkMemberFunction(const std::string &name, Func &&bind)
+{
+  std::vector<Receiver> receivers(slotCount);
+  sigs::Signal<void(int &)> s;
+
+  const auto allocs = bench::allocationsPerOp(
+    [&] {
+      for (auto &receiver : receivers) {
+        s.connect(bind(receiver));
+      }
+    },
+    slotCount);
+  bench::report(name, "allocs/connect", allocs);
+
+  const auto ns = bench::nsPerOp(
+    [&] {
+      int i = 0;
+      s(i);
+      bench::doNotOptimize(i);
+    },
+    slotCount);
+  bench::report(name, "ns/emitted slot", ns);
+}
+
+void benchmarkSignal()
+{
+  int a = 1, b = 2, c = 3;
+  sigs::Signal<void(int &)> s;
+
+  const auto allocs = bench::allocationsPerOp(
+    [&] {
+      for (std::size_t n = 0; n < slotCount; ++n) {
+        s.connect(makeSlot(&a, &b, &c, static_cast<int>(n)));
+      }
+    },
+    slotCount);
+  bench::report("sigs::Signal", "allocs/connect", allocs);
+
+  const auto ns = bench::nsPerOp(
+    [&] {
+      int i = 0;
+      s(i);
+      bench::doNotOptimize(i);
+    },
+    slotCount);
+  bench::report("sigs::Signal", "ns/emitted slot", ns);
+}
+
+} // namespace
+
+int main()
+{
+  benchmarkInvoke<std::function<void(int &)>>("std::function");
+  benchmarkInvoke<sigs::Delegate<void(int &)>>("sigs::Delegate");
+  benchmarkSignal();
+  benchmarkFunctions();
+
+  using Slot = sigs::Signal<void(int &)>::SlotType;
+  benchmarkMemberFunction("member function (std::bind)", [](Receiver &receiver) {
+    return Slot(std::function<void(int &)>(
+      std::bind(&Receiver::receive, &receiver, std::placeholders::_1)));
+  });
+  benchmarkMemberFunction("member function (runtime)", [](Receiver &receiver) {
+    return Slot::bind(&receiver, &Receiver::receive);
+  });
+  benchmarkMemberFunction("member function (compile-time)", [](Receiver &receiver) {
+    return Slot::bind<&Receiver::receive>(&receiver);
+  });
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Measures the cost of emitting a signal depending on the number of slots, on chaining signals, and
+// on collecting return values.
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+void benchmarkSlotCount()
+{
+  sigs::Signal<void(int &)> empty;
+  auto emitEmpty = [&empty] {
+    int i = 0;
+    empty(i);
+    bench::doNotOptimize(i);
+  };
+  bench::report("0 slots", "ns/emission", bench::nsPerOp(emitEmpty));
+
+  for (const std::size_t slots : {1, 10, 100, 1000}) {
+    sigs::Signal<void(int &)> s;
+    for (std::size_t n = 0; n < slots; ++n) {
+      s.connect([](int &i) { i++; });
+    }
+
+    const auto ns = bench::nsPerOp([&] {
+      int i = 0;
+      s(i);
+      bench::doNotOptimize(i);
+    });
+    const auto name = std::to_string(slots) + (slots == 1 ? " slot" : " slots");
+    bench::report(name, "ns/emission", ns);
+    bench::report(name, "ns/emitted slot", ns / static_cast<double>(slots));
+  }
+}
+
+void benchmarkChain()
+{
+  using Signal = sigs::Signal<void(int &)>;
+
+  for (const std::size_t depth : {1, 4, 16}) {
+    // Each signal is connected to the next one and only the last one has a slot.
+    std::vector<std::unique_ptr<Signal>> chain;
+    for (std::size_t n = 0; n <= depth; ++n) {
+      chain.push_back(std::make_unique<Signal>());
+      if (n > 0) {
+        chain[n - 1]->connect(*chain[n]);
+      }
+    }
+    chain.back()->connect([](int &i) { i++; });
+
+    const auto ns = bench::nsPerOp([&] {
+      int i = 0;
+      (*chain.front())(i);
+      bench::doNotOptimize(i);
+    });
+    const auto name = std::to_string(depth) + (depth == 1 ? " chained signal" : " chained signals");
+    bench::report(name, "ns/emission", ns);
+    bench::report(name, "ns/chained signal", ns / static_cast<double>(depth));
+  }
+}
+
+void benchmarkReturnValues()
+{
+  constexpr std::size_t slotCount = 100;
+
+  sigs::Signal<int(int)> s;
+  for (std::size_t n = 0; n < slotCount; ++n) {
+    s.connect([n](int i) { return i + static_cast<int>(n); });
+  }
+
+  auto ignored = [&s] { s(1); };
+  bench::report("return values ignored", "ns/emitted slot", bench::nsPerOp(ignored, slotCount));
+
+  auto retFunc = [&s] {
+    int sum = 0;
+    s([&sum](int r) { sum += r; }, 1);
+    bench::doNotOptimize(sum);
+  };
+  bench::report("return values (retFunc)", "ns/emitted slot", bench::nsPerOp(retFunc, slotCount));
+
+  auto combiner = [&s] {
+    auto sum = s.emit<sigs::collect::Sum>(1);
+    bench::doNotOptimize(sum);
+  };
+  bench::report("return values (collect::Sum)", "ns/emitted slot",
+                bench::nsPerOp(combiner, slotCount));
+}
+
+} // namespace
+
+int main()
+{
+  benchmarkSlotCount();
+  benchmarkChain();
+  benchmarkReturnValues();
+  return 0;
+}
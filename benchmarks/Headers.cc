@@ -0,0 +1,49 @@
+// Compares emitting a signal of sigs.h with invoking a vector of std::function and an array of
+// function pointers, which is the floor, on the workload that Headers17.cc runs with sigs17.h.
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "Headers.h"
+#include "sigs.h"
+
+namespace {
+
+void increment(int &i)
+{
+  i++;
+}
+
+void benchmark(std::size_t slotCount)
+{
+  std::vector<void (*)(int &)> pointers(slotCount, &increment);
+  headers::measure("function pointer array", slotCount, [&pointers](int &i) {
+    for (const auto pointer : pointers) {
+      pointer(i);
+    }
+  });
+
+  std::vector<std::function<void(int &)>> functions(slotCount, [](int &i) { i++; });
+  headers::measure("std::function vector", slotCount, [&functions](int &i) {
+    for (const auto &function : functions) {
+      function(i);
+    }
+  });
+
+  sigs::Signal<void(int &)> s;
+  for (std::size_t n = 0; n < slotCount; ++n) {
+    s.connect([](int &i) { i++; });
+  }
+  headers::measure("sigs.h", slotCount, [&s](int &i) { s(i); });
+}
+
+} // namespace
+
+int main()
+{
+  for (const auto slotCount : headers::slotCounts) {
+    benchmark(slotCount);
+  }
+  return 0;
+}
@@ -0,0 +1,36 @@
+// Shared by the benchmarks comparing sigs.h with sigs17.h, which can't be included together and are
+// measured by separate executables.
+
+#ifndef SIGS_BENCHMARK_HEADERS_H
+#define SIGS_BENCHMARK_HEADERS_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "Benchmark.h"
+
+namespace headers {
+
+/// Numbers of slots both benchmarks are run with, so that their results line up.
+inline constexpr std::array<std::size_t, 2> slotCounts{10, 1000};
+
+/// Reports the time and instructions per slot invocation of \p emit, which invokes \p slotCount
+/// slots that each increment their argument.
+template <typename Emit>
+void measure(const std::string &name, std::size_t slotCount, Emit &&emit)
+{
+  auto run = [&emit] {
+    int i = 0;
+    emit(i);
+    bench::doNotOptimize(i);
+  };
+  const auto fullName = name + ", " + std::to_string(slotCount) + " slots";
+  bench::report(fullName, "ns/invocation", bench::nsPerOp(run, slotCount));
+  bench::reportEvent(fullName, "instructions/invocation", bench::Event::Instructions, run,
+                     slotCount);
+}
+
+} // namespace headers
+
+#endif // SIGS_BENCHMARK_HEADERS_H
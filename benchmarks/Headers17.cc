@@ -0,0 +1,18 @@
+// Runs the workload of Headers.cc with sigs17.h, which can't be included together with sigs.h.
+
+#include <cstddef>
+
+#include "Headers.h"
+#include "sigs17.h"
+
+int main()
+{
+  for (const auto slotCount : headers::slotCounts) {
+    sigs::Signal<void(int &)> s;
+    for (std::size_t n = 0; n < slotCount; ++n) {
+      s.connect([](int &i) { i++; });
+    }
+    headers::measure("sigs17.h", slotCount, [&s](int &i) { s(i); });
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+// Measures the cost per emitted slot of sigs::Signal for growing slot counts, compared with an
+// array of structures holding the slot next to its connection bookkeeping as entries were stored
+// before.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+void increment(int &i)
+{
+  i++;
+}
+
+/// Entry layout that interleaves the callable with the cold connection bookkeeping.
+struct AosEntry {
+  sigs::Delegate<void(int &)> slot;
+  std::shared_ptr<void> conn;
+  void *signal = nullptr;
+};
+
+void benchmarkAos(std::size_t slotCount)
+{
+  int n = 1;
+  std::vector<AosEntry> entries;
+  for (std::size_t k = 0; k < slotCount; ++k) {
+    entries.push_back({[&n](int &i) { i += n; }, std::make_shared<int>(), nullptr});
+  }
+
+  auto emit = [&] {
+    int i = 0;
+    for (const auto &entry : entries) {
+      if (entry.signal == nullptr) {
+        entry.slot(i);
+      }
+    }
+    bench::doNotOptimize(i);
+  };
+
+  const auto name = "array of structures, " + std::to_string(slotCount) + " slots";
+  bench::report(name, "ns/slot", bench::nsPerOp(emit, slotCount));
+  bench::reportEvent(name, "L1d misses/slot", bench::Event::L1dMisses, emit, slotCount);
+  bench::reportEvent(name, "LLC misses/slot", bench::Event::LlcMisses, emit, slotCount);
+}
+
+template <typename Connect>
+void benchmarkSignal(const std::string &kind, std::size_t slotCount, Connect &&connect)
+{
+  sigs::Signal<void(int &)> s;
+  for (std::size_t k = 0; k < slotCount; ++k) {
+    connect(s);
+  }
+
+  auto emit = [&] {
+    int i = 0;
+    s(i);
+    bench::doNotOptimize(i);
+  };
+
+  const auto name = "sigs::Signal " + kind + ", " + std::to_string(slotCount) + " slots";
+  bench::report(name, "ns/slot", bench::nsPerOp(emit, slotCount));
+  bench::reportEvent(name, "L1d misses/slot", bench::Event::L1dMisses, emit, slotCount);
+  bench::reportEvent(name, "LLC misses/slot", bench::Event::LlcMisses, emit, slotCount);
+}
+
+} // namespace
+
+int main()
+{
+  if (!bench::Counter(bench::Event::L1dMisses).valid()) {
+    std::printf("Hardware cache counters are unavailable, only reporting time.\n");
+  }
+
+  int n = 1;
+  for (const std::size_t slotCount : {10, 1000, 100000}) {
+    benchmarkAos(slotCount);
+    benchmarkSignal("lambdas", slotCount, [&n](auto &s) { s.connect([&n](int &i) { i += n; }); });
+    benchmarkSignal("functions", slotCount, [](auto &s) { s.connect(increment); });
+  }
+  return 0;
+}
@@ -0,0 +1,66 @@
+// Measures the short critical sections of connecting, disconnecting, and querying a signal from 1
+// to 64 threads at once, comparing the default lock with the spinning futex lock.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+/// Operations of all threads together per round, so that every thread count takes similarly long.
+constexpr std::size_t totalOps = 100000;
+
+/// Average wall-clock nanoseconds per operation while \p threads threads modify \p s concurrently.
+/** Each operation connects a slot, queries the number of slots, and disconnects the slot again. */
+template <typename Signal>
+double nsPerOp(Signal &s, unsigned threads)
+{
+  const auto ops = std::max<std::size_t>(totalOps / threads, 100);
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&s, ops] {
+      std::size_t size = 0;
+      for (std::size_t i = 0; i < ops; ++i) {
+        auto conn = s.connect([](int /*unused*/) {});
+        size += s.size();
+        conn->disconnect();
+      }
+      bench::doNotOptimize(size);
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(ops * threads);
+}
+
+template <typename Signal>
+void run(const std::string &name)
+{
+  Signal s;
+  for (unsigned threads = 1; threads <= 64; threads *= 2) {
+    // Fastest of three rounds, like bench::nsPerOp().
+    double best = 0;
+    for (int round = 0; round < 3; ++round) {
+      const auto ns = nsPerOp(s, threads);
+      best = round == 0 ? ns : std::min(best, ns);
+    }
+    bench::report(name + ", " + std::to_string(threads) + " threads", "ns/op", best);
+  }
+}
+
+} // namespace
+
+int main()
+{
+  run<sigs::Signal<void(int)>>("BasicLock");
+  run<sigs::FastSignal<void(int)>>("SpinFutexLock");
+  return 0;
+}
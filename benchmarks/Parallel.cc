@@ -0,0 +1,54 @@
+// Measures how emitting a signal with many CPU-heavy slots via emitParallel() scales with the
+// number of cores, compared with emitting it serially.
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+constexpr std::size_t slotCount = 512;
+
+/// CPU-bound slot that doesn't touch any shared memory.
+void heavy(const unsigned &seed)
+{
+  unsigned value = seed;
+  for (int i = 0; i < 1000; ++i) {
+    value = value * 1664525u + 1013904223u;
+  }
+  bench::doNotOptimize(value);
+}
+
+} // namespace
+
+int main()
+{
+  sigs::Signal<void(const unsigned &)> s;
+  for (std::size_t i = 0; i < slotCount; ++i) {
+    s.connect(heavy);
+  }
+
+  const auto serial = bench::nsPerOp([&] { s(42); }, slotCount);
+  bench::report("serial emission", "ns/slot", serial);
+
+  const auto cores = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= cores; ++threads) {
+    // The emitting thread runs a chunk too, so the pool has one worker less. Workers are pinned to
+    // distinct cores, leaving core 0 to the emitting thread.
+    std::vector<int> cpus;
+    for (unsigned cpu = 1; cpu < threads; ++cpu) {
+      cpus.push_back(static_cast<int>(cpu));
+    }
+    sigs::ThreadPool pool(threads - 1, cpus);
+
+    const auto ns = bench::nsPerOp([&] { s.emitParallel(pool, 42); }, slotCount);
+    const auto name = "parallel emission, " + std::to_string(threads) + " threads";
+    bench::report(name, "ns/slot", ns);
+    bench::report(name, "speedup", serial / ns);
+  }
+  return 0;
+}
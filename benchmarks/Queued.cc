@@ -0,0 +1,36 @@
+// Measures queued connections, whose slots are invoked when the event loop is drained, in the
+// steady state where all events come from the pool of the connection.
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+constexpr std::size_t eventCount = 32;
+
+} // namespace
+
+int main()
+{
+  sigs::EventLoop loop;
+  sigs::Signal<void(int)> s;
+
+  int sum = 0;
+  s.connect(loop, [&sum](int value) { sum += value; }, eventCount);
+
+  auto emitAndDrain = [&] {
+    for (std::size_t i = 0; i < eventCount; ++i) {
+      s(1);
+    }
+    loop.drain();
+  };
+
+  // Warm up.
+  emitAndDrain();
+
+  bench::report("queued connection", "allocs/event",
+                bench::allocationsPerOp(emitAndDrain, eventCount));
+  bench::report("queued connection", "ns/event", bench::nsPerOp(emitAndDrain, eventCount));
+  bench::doNotOptimize(sum);
+  return 0;
+}
@@ -0,0 +1,45 @@
+// Measures the fixed costs of a signal that only one thread uses, which a default signal pays for
+// locking and atomic bookkeeping while a single-threaded signal doesn't.
+
+#include <string>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+template <typename Signal>
+void run(const std::string &name)
+{
+  Signal s;
+  s.connect([](int &i) { i++; });
+  const auto conn = s.connect([](int & /*unused*/) {});
+
+  auto emit = [&s] {
+    int i = 0;
+    s(i);
+    bench::doNotOptimize(i);
+  };
+  bench::report(name + ", emit", "ns/op", bench::nsPerOp(emit));
+
+  auto connectDisconnect = [&s] {
+    auto other = s.connect([](int & /*unused*/) {});
+    s.disconnect(other);
+  };
+  bench::report(name + ", connect and disconnect", "ns/op", bench::nsPerOp(connectDisconnect));
+
+  auto copyConnection = [&conn] {
+    auto copy = conn;
+    bench::doNotOptimize(copy);
+  };
+  bench::report(name + ", copy connection", "ns/op", bench::nsPerOp(copyConnection));
+}
+
+} // namespace
+
+int main()
+{
+  run<sigs::Signal<void(int &)>>("sigs::Signal");
+  run<sigs::SignalST<void(int &)>>("sigs::SignalST");
+  return 0;
+}
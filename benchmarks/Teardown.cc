@@ -0,0 +1,114 @@
+// Measures connecting many slots one by one or all at once, and disconnecting them one by one or as
+// a ConnectionSet, like when setting up and tearing down an object that is connected to a few
+// signals.
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "sigs.h"
+
+namespace {
+
+constexpr std::size_t signalCount = 3;
+constexpr std::size_t connectionCount = 3000;
+
+/// Connects the slots with \p connect, which returns their connections spread over the signals
+/// in turn, and disconnects them with \p disconnect. Returns the nanoseconds per connection of
+/// each, which are timed separately.
+template <typename Signal, typename Connect, typename Disconnect>
+std::pair<double, double> timeNs(std::vector<Signal> &signals, Connect &&connect,
+                                 Disconnect &&disconnect)
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto perConnection = [](Clock::time_point start) {
+    const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / static_cast<double>(connectionCount);
+  };
+
+  std::pair<double, double> best;
+  for (int round = 0; round < 10; ++round) {
+    auto start = Clock::now();
+    std::vector<sigs::Connection> conns = connect(signals);
+    const auto connectNs = perConnection(start);
+
+    start = Clock::now();
+    disconnect(conns);
+    const auto disconnectNs = perConnection(start);
+
+    if (round == 0 || connectNs < best.first) {
+      best.first = connectNs;
+    }
+    if (round == 0 || disconnectNs < best.second) {
+      best.second = disconnectNs;
+    }
+  }
+  return best;
+}
+
+template <typename Signal>
+std::vector<sigs::Connection> connectOneByOne(std::vector<Signal> &signals)
+{
+  std::vector<sigs::Connection> conns;
+  for (std::size_t i = 0; i < connectionCount; ++i) {
+    conns.emplace_back(signals[i % signalCount].connect([] {}));
+  }
+  return conns;
+}
+
+template <typename Signal>
+std::vector<sigs::Connection> connectAll(std::vector<Signal> &signals)
+{
+  auto slot = [] {};
+  const std::vector<decltype(slot)> slots(connectionCount / signalCount, slot);
+  std::vector<std::vector<sigs::Connection>> connected;
+  for (auto &signal : signals) {
+    connected.emplace_back(signal.connectAll(slots));
+  }
+
+  std::vector<sigs::Connection> conns;
+  for (std::size_t i = 0; i < connectionCount; ++i) {
+    conns.emplace_back(std::move(connected[i % signalCount][i / signalCount]));
+  }
+  return conns;
+}
+
+template <typename Signal>
+void teardown(const std::string &kind)
+{
+  std::vector<Signal> signals(signalCount);
+
+  auto oneByOne = [](std::vector<sigs::Connection> &conns) {
+    for (auto &conn : conns) {
+      conn->disconnect();
+    }
+  };
+  auto asSet = [](std::vector<sigs::Connection> &conns) {
+    sigs::ConnectionSet set;
+    for (auto &conn : conns) {
+      set += std::move(conn);
+    }
+    set.disconnect();
+  };
+
+  const auto name = kind + ", " + std::to_string(connectionCount) + " connections";
+  const auto [connectNs, disconnectNs] = timeNs(signals, connectOneByOne<Signal>, oneByOne);
+  bench::report(name + " one by one", "ns/connect", connectNs);
+  bench::report(name + " one by one", "ns/disconnect", disconnectNs);
+
+  const auto [connectAllNs, setNs] = timeNs(signals, connectAll<Signal>, asSet);
+  bench::report(name + " all at once", "ns/connect", connectAllNs);
+  bench::report(name + " as set", "ns/disconnect", setNs);
+}
+
+} // namespace
+
+int main()
+{
+  teardown<sigs::Signal<void()>>("locked");
+  teardown<sigs::EpochSignal<void()>>("epoch");
+  return 0;
+}
@@ -17,6 +17,10 @@ public:
     });
 
     std::cout << "Sum of calculation: " << sum << std::endl;
+
+    if (const auto max = executeSignal_.emit<sigs::collect::Max>(); max) {
+      std::cout << "Largest value: " << *max << std::endl;
+    }
   }
 
   [[nodiscard]] auto executeSignal()
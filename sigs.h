@@ -26,43 +26,41 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef SIGS_SIGNAL_SLOT_H
 #define SIGS_SIGNAL_SLOT_H
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <iterator>
 #include <functional>
+#include <limits>
+#include <latch>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <new>
 #include <optional>
+#include <ranges>
+#include <shared_mutex>
+#include <span>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
-// The following is used for making variadic type lists for binding member functions and their
-// parameters.
-namespace sigs {
-
-template <std::size_t... Ns>
-class Seq {};
-
-template <std::size_t N, std::size_t... Ns>
-class MakeSeq : public MakeSeq<N - 1, N - 1, Ns...> {};
-
-template <std::size_t... Ns>
-class MakeSeq<0, Ns...> : public Seq<Ns...> {};
-
-template <std::size_t>
-class Placeholder {};
-
-} // namespace sigs
-
-// std::bind uses std::is_placeholder to detect placeholders for unbounded arguments, so it must be
-// overridden to accept the custom sigs::Placeholder type.
-namespace std {
-
-template <size_t N>
-class is_placeholder<sigs::Placeholder<N>> : public integral_constant<std::size_t, N + 1> {};
-
-} // namespace std
+#ifdef __linux__
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace sigs {
 
@@ -85,349 +83,4260 @@ struct Use final {
   }
 };
 
-class ConnectionBase final {
-  template <typename, typename>
-  friend class BasicSignal;
+/// Determines how a BasicSignal invokes its slots with respect to its entries lock.
+enum class Emission {
+  /// The entries lock is held while all slots are invoked. Connecting and disconnecting wait for
+  /// ongoing emissions to finish, so a disconnected slot is never invoked afterwards. Modifications
+  /// made by the emitting thread itself, like from within a slot, are deferred until the outermost
+  /// emission exits instead, and slots disconnected that way are skipped by it.
+  Locked,
 
-public:
-  ConnectionBase() noexcept = default;
-  ~ConnectionBase() noexcept = default;
+  /// Each emission takes an immutable, reference-counted snapshot of the entries and invokes the
+  /// slots without holding the entries lock. Concurrent emissions run in parallel and slots may
+  /// connect to or disconnect from the signal being emitted, but an emission that is already
+  /// running can still invoke a slot that was disconnected meanwhile.
+  Snapshot,
 
-  ConnectionBase(const ConnectionBase &) noexcept = default;
-  ConnectionBase(ConnectionBase &&) noexcept = default;
+  /// Emissions walk the published entries without taking any lock or reference, protected by
+  /// epoch-based reclamation. Modifications publish a new copy of the entries, and the previous one
+  /// is freed later, once no emission can be using it anymore. Disconnecting waits for the
+  /// emissions of other threads that may still be invoking slots of the signal, but not for those
+  /// of other signals, so a disconnected slot is never invoked after the disconnect returns.
+  /// Disconnecting from within a slot doesn't wait, to avoid deadlocks between emitting threads,
+  /// and only the emissions of the calling thread skip the disconnected slots then.
+  Epoch,
+};
 
-  ConnectionBase &operator=(const ConnectionBase &) noexcept = default;
-  ConnectionBase &operator=(ConnectionBase &&) noexcept = default;
+/// Order in which BasicSignal::emitBatch() invokes the slots.
+enum class BatchOrder {
+  /// Each event of the batch is passed to all slots before the next one.
+  EventMajor,
 
-  void disconnect()
-  {
-    if (deleter) deleter();
-  }
+  /// Each slot is invoked with all events of the batch before the next slot.
+  SlotMajor,
+};
 
-private:
-  std::function<void()> deleter;
+/// Compile-time options of a BasicSignal.
+/** Derive from it and shadow a subset of the options to customize a signal type. */
+struct DefaultPolicy {
+  static constexpr Emission emission = Emission::Locked;
+
+  /// Maximum size in bytes of slot callables that are stored inline instead of on the heap.
+  static constexpr std::size_t slotCapacity = 32;
+
+  /// Number of entries invoked per task by BasicSignal::emitParallel(), or zero to split the
+  /// entries evenly between the executor and the emitting thread.
+  static constexpr std::size_t parallelChunkSize = 0;
+
+  /// Allocator of the entries, connections, and heap-stored slots of a signal, which is rebound to
+  /// each type it allocates. A signal can be constructed with an instance of it, see PmrPolicy.
+  using Allocator = std::allocator<std::byte>;
+
+  /// Whether the signal can be used from several threads. Otherwise blocking, the bookkeeping of
+  /// emissions, and the signals and reference counts of its connections use plain instead of atomic
+  /// variables, which requires locked emission and is meant to be combined with NullLock.
+  static constexpr bool threadSafe = true;
 };
 
-using Connection = std::shared_ptr<ConnectionBase>;
+struct SnapshotPolicy : DefaultPolicy {
+  static constexpr Emission emission = Emission::Snapshot;
+};
 
-namespace detail {
+struct EpochPolicy : DefaultPolicy {
+  static constexpr Emission emission = Emission::Epoch;
+};
 
-/// VoidableFunction is used internally to generate a function type depending on whether the return
-/// type of the signal is non-void.
-template <typename T>
-class VoidableFunction final {
-public:
-  using func = std::function<void(T)>;
+struct SingleThreadPolicy : DefaultPolicy {
+  static constexpr bool threadSafe = false;
 };
 
-/// Specialization for void return types.
-template <>
-class VoidableFunction<void> final {
-public:
-  using func = std::function<void()>;
+/// Policy of signals allocating from a `std::pmr::memory_resource`, like a monotonic or pool
+/// arena, which is given when constructing the signal.
+struct PmrPolicy : DefaultPolicy {
+  using Allocator = std::pmr::polymorphic_allocator<std::byte>;
 };
 
-} // namespace detail
+/// Type-erased callable similar to std::function, which stores small callables inline.
+/** Callables that are trivially copyable and fit within `Capacity` bytes are stored inline, and
+    larger ones are allocated on the heap by `Allocator`. Either way the delegate itself is
+    trivially relocatable, so moving it never allocates, and invoking it is a single indirect call.
 
-template <typename, typename>
-class BasicSignal;
+    The allocator is propagated like by the allocator-aware standard containers, and the
+    constructors taking an allocator copy or move a callable into the storage of another one. */
+template <typename, std::size_t Capacity = DefaultPolicy::slotCapacity,
+          typename Allocator = DefaultPolicy::Allocator>
+class Delegate;
 
-template <typename Sig>
-class SignalBlocker {
-  static_assert(std::is_base_of_v<BasicSignal<typename Sig::RetArgs, typename Sig::LockType>, Sig>,
-                "Sig must extend sigs::BasicSignal");
+template <typename Ret, typename... Args, std::size_t Capacity, typename Allocator>
+class Delegate<Ret(Args...), Capacity, Allocator> final {
+  struct alignas(std::max_align_t) Storage final {
+    unsigned char bytes[Capacity];
+  };
+
+  using Invoke = Ret (*)(Storage &, Args &&...);
+
+  /// Copies the callable of the source into the destination, or destroys the destination callable
+  /// if no source is given, allocating or deallocating with the allocator.
+  using Manage = void (*)(Storage &, const Storage *, const Allocator &);
+
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+
+  template <typename F>
+  using Traits = typename AllocatorTraits::template rebind_traits<F>;
+
+  template <typename F>
+  static constexpr bool storedInline = sizeof(F) <= Capacity &&
+                                       alignof(F) <= alignof(Storage) &&
+                                       std::is_trivially_copyable_v<F>;
 
 public:
-  explicit constexpr SignalBlocker(Sig *sig) noexcept : sig_(sig)
+  static constexpr std::size_t capacity = Capacity;
+
+  constexpr Delegate() noexcept = default;
+
+  constexpr Delegate(std::nullptr_t) noexcept
   {
-    reblock();
   }
 
-  explicit constexpr SignalBlocker(Sig &sig) noexcept : sig_(&sig)
+  template <typename F, typename Fn = std::decay_t<F>>
+    requires(!std::is_same_v<Fn, Delegate> && std::is_invocable_r_v<Ret, Fn &, Args...>)
+  Delegate(F &&func, const Allocator &allocator_ = Allocator()) noexcept : allocator(allocator_)
   {
-    reblock();
+    if constexpr (storedInline<Fn>) {
+      ::new (static_cast<void *>(&storage)) Fn(std::forward<F>(func));
+      invoke_ = &invokeInline<Fn>;
+    }
+    else {
+      ::new (static_cast<void *>(&storage)) Fn *(allocate<Fn>(allocator, std::forward<F>(func)));
+      invoke_ = &invokeHeap<Fn>;
+      manage_ = &manageHeap<Fn>;
+    }
   }
 
-  virtual constexpr ~SignalBlocker() noexcept
+  ~Delegate() noexcept
   {
-    unblock();
+    reset();
   }
 
-  constexpr SignalBlocker(const SignalBlocker &rhs) = delete;
-  constexpr SignalBlocker &operator=(const SignalBlocker &rhs) = delete;
+  Delegate(const Delegate &rhs) noexcept
+    : Delegate(rhs, AllocatorTraits::select_on_container_copy_construction(rhs.allocator))
+  {
+  }
 
-  constexpr SignalBlocker(SignalBlocker &&rhs) noexcept
+  /// Copies the callable of \p rhs, allocating it with \p allocator_ if it's stored on the heap.
+  Delegate(const Delegate &rhs, const Allocator &allocator_) noexcept
+    : invoke_(rhs.invoke_), manage_(rhs.manage_), allocator(allocator_)
   {
-    moveAssign(std::move(rhs));
+    if (manage_) {
+      manage_(storage, &rhs.storage, allocator);
+    }
+    else {
+      storage = rhs.storage;
+    }
   }
 
-  /// Unblocks `this` if signals of `this` and `rhs` aren't the same.
-  constexpr SignalBlocker &operator=(SignalBlocker &&rhs) noexcept
+  Delegate(Delegate &&rhs) noexcept
+    : storage(rhs.storage), invoke_(rhs.invoke_), manage_(rhs.manage_),
+      allocator(std::move(rhs.allocator))
   {
-    if (sig_ != rhs.sig_) {
-      unblock();
+    rhs.invoke_ = nullptr;
+    rhs.manage_ = nullptr;
+  }
+
+  /// Moves the callable of \p rhs, which is only copied if it's stored on the heap and \p
+  /// allocator_ doesn't compare equal to the allocator of \p rhs.
+  Delegate(Delegate &&rhs, const Allocator &allocator_) noexcept
+    : invoke_(rhs.invoke_), manage_(rhs.manage_), allocator(allocator_)
+  {
+    if (manage_ && !(rhs.allocator == allocator)) {
+      manage_(storage, &rhs.storage, allocator);
+      rhs.reset();
     }
+    else {
+      storage = rhs.storage;
+      rhs.invoke_ = nullptr;
+      rhs.manage_ = nullptr;
+    }
+  }
 
-    moveAssign(std::move(rhs));
+  Delegate &operator=(const Delegate &rhs) noexcept
+  {
+    if (this != &rhs) {
+      if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value) {
+        *this = Delegate(rhs, rhs.allocator);
+      }
+      else {
+        *this = Delegate(rhs, allocator);
+      }
+    }
     return *this;
   }
 
-  constexpr void reblock() noexcept
+  Delegate &operator=(Delegate &&rhs) noexcept
   {
-    if (sig_) {
-      previous = sig_->setBlocked(true);
+    if (this == &rhs) return *this;
+
+    reset();
+    if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+      allocator = std::move(rhs.allocator);
     }
+    else if (rhs.manage_ && !(rhs.allocator == allocator)) {
+      // The callable can't be freed by this allocator, so it's copied instead.
+      invoke_ = rhs.invoke_;
+      manage_ = rhs.manage_;
+      manage_(storage, &rhs.storage, allocator);
+      rhs.reset();
+      return *this;
+    }
+    storage = rhs.storage;
+    invoke_ = std::exchange(rhs.invoke_, nullptr);
+    manage_ = std::exchange(rhs.manage_, nullptr);
+    return *this;
   }
 
-  constexpr void unblock() noexcept
+  Ret operator()(Args... args) const
   {
-    if (sig_) {
-      sig_->setBlocked(previous);
-    }
+    assert(invoke_ && "Invoking empty delegate.");
+    return invoke_(storage, std::forward<Args>(args)...);
   }
 
-private:
-  constexpr void moveAssign(SignalBlocker &&rhs)
+  explicit operator bool() const noexcept
   {
-    sig_ = rhs.sig_;
-    previous = rhs.previous;
+    return invoke_ != nullptr;
+  }
 
-    // `rhs` won't do any action on destruction.
-    rhs.sig_ = nullptr;
+  /// Binds member function \p mf to \p instance.
+  /** Stores the instance and member function pointers inline, so no allocation is needed. */
+  template <typename Instance, typename MembFunc>
+  [[nodiscard]] static Delegate bind(Instance *instance, MembFunc Instance::*mf) noexcept
+  {
+    return [instance, mf](auto &&...args) {
+      return std::invoke(mf, instance, std::forward<decltype(args)>(args)...);
+    };
   }
 
-  Sig *sig_ = nullptr;
-  bool previous = false;
-};
+  /// Binds member function `MembFunc` to \p instance.
+  /** The member function is known at compile-time and called directly. */
+  template <auto MembFunc, typename Instance>
+    requires std::is_member_function_pointer_v<decltype(MembFunc)>
+  [[nodiscard]] static Delegate bind(Instance *instance) noexcept
+  {
+    return [instance](auto &&...args) {
+      return std::invoke(MembFunc, instance, std::forward<decltype(args)>(args)...);
+    };
+  }
 
-/// Suppress CTAD warning.
-template <typename Sig>
-SignalBlocker(Sig) -> SignalBlocker<Sig>;
+  /// Whether the callable is stored on the heap.
+  [[nodiscard]] bool allocated() const noexcept
+  {
+    return manage_ != nullptr;
+  }
 
-template <typename Ret, typename... Args, typename Lock>
-class BasicSignal<Ret(Args...), Lock> {
-public:
-  using RetArgs = Ret(Args...);
-  using SignalType = BasicSignal<RetArgs, Lock>;
-  using LockType = Lock;
-  using ReturnType = Ret;
+  [[nodiscard]] Allocator get_allocator() const noexcept
+  {
+    return allocator;
+  }
 
 private:
-  using Slot = std::function<RetArgs>;
-  using Mutex = typename Lock::mutex_type;
-
-  class Entry final {
-  public:
-    Entry(const Slot &slot, Connection conn) noexcept
-      : slot_(slot), conn_(std::move(conn)), signal_(nullptr)
-    {
+  void reset() noexcept
+  {
+    if (manage_) {
+      manage_(storage, nullptr, allocator);
+      manage_ = nullptr;
     }
+    invoke_ = nullptr;
+  }
 
-    Entry(Slot &&slot, Connection conn) noexcept
-      : slot_(std::move(slot)), conn_(std::move(conn)), signal_(nullptr)
-    {
-    }
+  template <typename F, typename... FArgs>
+  static F *allocate(const Allocator &allocator, FArgs &&...args) noexcept
+  {
+    typename Traits<F>::allocator_type rebound(allocator);
+    auto *func = Traits<F>::allocate(rebound, 1);
+    Traits<F>::construct(rebound, func, std::forward<FArgs>(args)...);
+    return func;
+  }
 
-    Entry(BasicSignal *signal, Connection conn) noexcept : conn_(std::move(conn)), signal_(signal)
-    {
-    }
+  template <typename F>
+  static F *heapCallable(const Storage &storage) noexcept
+  {
+    return *std::launder(reinterpret_cast<F *const *>(&storage));
+  }
 
-    constexpr const Slot &slot() const noexcept
-    {
-      return slot_;
+  template <typename F>
+  static Ret invokeInline(Storage &storage, Args &&...args)
+  {
+    auto &func = *std::launder(reinterpret_cast<F *>(&storage));
+    if constexpr (std::is_void_v<Ret>) {
+      std::invoke(func, std::forward<Args>(args)...);
+    }
+    else {
+      return std::invoke(func, std::forward<Args>(args)...);
     }
+  }
 
-    constexpr BasicSignal *signal() const noexcept
-    {
-      return signal_;
+  template <typename F>
+  static Ret invokeHeap(Storage &storage, Args &&...args)
+  {
+    auto &func = *heapCallable<F>(storage);
+    if constexpr (std::is_void_v<Ret>) {
+      std::invoke(func, std::forward<Args>(args)...);
+    }
+    else {
+      return std::invoke(func, std::forward<Args>(args)...);
     }
+  }
 
-    [[nodiscard]] Connection conn() const noexcept
-    {
-      return conn_;
+  template <typename F>
+  static void manageHeap(Storage &dst, const Storage *src, const Allocator &allocator) noexcept
+  {
+    if (src) {
+      ::new (static_cast<void *>(&dst)) F *(allocate<F>(allocator, *heapCallable<F>(*src)));
+    }
+    else {
+      typename Traits<F>::allocator_type rebound(allocator);
+      auto *func = heapCallable<F>(dst);
+      Traits<F>::destroy(rebound, func);
+      Traits<F>::deallocate(rebound, func, 1);
     }
+  }
 
-  private:
-    Slot slot_;
-    Connection conn_;
-    BasicSignal *signal_;
-  };
+  /// Mutable like the target of std::function, which is invoked as non-const.
+  mutable Storage storage{};
+  Invoke invoke_ = nullptr;
+  Manage manage_ = nullptr;
+  [[no_unique_address]] Allocator allocator;
+};
 
-  using Cont = std::vector<Entry>;
+template <typename, typename, typename = DefaultPolicy>
+class BasicSignal;
+
+template <typename, auto...>
+class StaticSignal;
+
+class Connection;
+
+/// Connection of a slot to a signal, which is shared by the signal and all Connection handles.
+/** It's allocated by the allocator of the signal, see ConnectionBase::Allocated. */
+class ConnectionBase {
+  template <typename, typename, typename>
+  friend class BasicSignal;
+  friend class Connection;
+  friend class ConnectionSet;
 
 public:
-  using SlotType = Slot;
+  ~ConnectionBase() noexcept = default;
 
-  /// Interface that only exposes connect and disconnect methods.
-  class Interface final {
-  public:
-    explicit constexpr Interface(SignalType *sig) noexcept : sig_(sig)
-    {
+  ConnectionBase(const ConnectionBase &) = delete;
+  ConnectionBase &operator=(const ConnectionBase &) = delete;
+
+  /// Disconnects the slot from the signal unless it's already disconnected.
+  void disconnect()
+  {
+    if (auto *sig = loadSignal(std::memory_order_acquire); sig) {
+      const ConnectionBase *self = this;
+      disconnectFrom(sig, {&self, 1});
     }
+  }
 
-    constexpr ~Interface() noexcept = default;
+private:
+  /// Disconnects \p conns from \p sig, which is the type-erased signal, taking its lock once.
+  /** Connections that aren't connected to \p sig are ignored. */
+  using Disconnect = void (*)(void *sig, std::span<const ConnectionBase *const> conns) noexcept;
 
-    constexpr Interface(const Interface &) = delete;
-    constexpr Interface(Interface &&) = delete;
+  /// Destroys and frees the connection once the last reference is released.
+  using Destroy = void (*)(ConnectionBase *) noexcept;
 
-    constexpr Interface &operator=(const Interface &) = delete;
-    constexpr Interface &operator=(Interface &&) = delete;
+  /// Connection along with the allocator that allocated it.
+  template <typename Allocator>
+  class Allocated;
 
-    Connection connect(const Slot &slot) noexcept
-    {
-      return sig_->connect(slot);
-    }
+  ConnectionBase(void *signal_, Disconnect disconnectFrom_, Destroy destroy_,
+                 bool threadSafe_) noexcept
+    : signal(signal_), disconnectFrom(disconnectFrom_), destroy(destroy_), threadSafe(threadSafe_)
+  {
+  }
 
-    Connection connect(Slot &&slot) noexcept
-    {
-      return sig_->connect(std::move(slot));
-    }
+  /// Allocates a connection of \p signal_ with \p allocator, whose single reference is returned.
+  template <typename Allocator>
+  [[nodiscard]] static ConnectionBase *make(const Allocator &allocator, void *signal_,
+                                            Disconnect disconnectFrom_, bool threadSafe_) noexcept
+  {
+    using Traits = typename Allocated<Allocator>::Traits;
+    typename Traits::allocator_type rebound(allocator);
+    auto *conn = Traits::allocate(rebound, 1);
+    Traits::construct(rebound, conn, allocator, signal_, disconnectFrom_, threadSafe_);
+    return conn;
+  }
 
-    template <typename Instance, typename MembFunc>
-    Connection connect(Instance *instance, MembFunc Instance::*mf) noexcept
-    {
-      return sig_->connect(instance, mf);
+  /// Adds a reference, which is a plain increment unless the signal is thread-safe.
+  void retain() noexcept
+  {
+    if (threadSafe) {
+      std::atomic_ref(refs).fetch_add(1, std::memory_order_relaxed);
     }
-
-    Connection connect(BasicSignal &signal) noexcept
-    {
-      return sig_->connect(signal);
+    else {
+      ++refs;
     }
+  }
 
-    void disconnect(std::optional<Connection> conn) noexcept
-    {
-      sig_->disconnect(conn);
+  /// Removes a reference and returns whether it was the last one.
+  [[nodiscard]] bool release() noexcept
+  {
+    if (threadSafe) {
+      return std::atomic_ref(refs).fetch_sub(1, std::memory_order_acq_rel) == 1;
     }
+    return --refs == 0;
+  }
 
-    constexpr void disconnect(BasicSignal &signal) noexcept
-    {
-      sig_->disconnect(signal);
+  /// Signal of the slot, which is null once the slot is disconnected or the signal destroyed.
+  [[nodiscard]] void *loadSignal(std::memory_order order) const noexcept
+  {
+    return threadSafe ? std::atomic_ref(signal).load(order) : signal;
+  }
+
+  void storeSignal(void *signal_, std::memory_order order) noexcept
+  {
+    if (threadSafe) {
+      std::atomic_ref(signal).store(signal_, order);
+    }
+    else {
+      signal = signal_;
     }
+  }
 
-  private:
-    SignalType *sig_ = nullptr;
-  };
+  /// Signal of the slot, see loadSignal(), which may be loaded through a const connection.
+  alignas(std::atomic_ref<void *>::required_alignment) mutable void *signal;
+  Disconnect disconnectFrom;
+  Destroy destroy;
 
-  constexpr BasicSignal() noexcept = default;
+  /// Number of Connection handles and signals referencing this connection.
+  alignas(std::atomic_ref<std::size_t>::required_alignment) std::size_t refs = 1;
 
-  constexpr virtual ~BasicSignal() noexcept
+  /// Key of the entry in the slot map of the signal, see BasicSignal::Cont::find().
+  std::size_t id = 0;
+  std::uint32_t generation = 0;
+
+  /// Whether handles may be copied and released from several threads, see
+  /// DefaultPolicy::threadSafe. Only then are `signal` and `refs` accessed atomically, through
+  /// `std::atomic_ref`, since connections of all policies share this type.
+  bool threadSafe;
+};
+
+template <typename Allocator>
+class ConnectionBase::Allocated final : public ConnectionBase {
+public:
+  using Traits = typename std::allocator_traits<Allocator>::template rebind_traits<Allocated>;
+
+  Allocated(const Allocator &allocator_, void *signal_, Disconnect disconnectFrom_,
+            bool threadSafe_) noexcept
+    : ConnectionBase(signal_, disconnectFrom_, &destroy, threadSafe_), allocator(allocator_)
   {
-    Lock lock(entriesMutex);
-    for (auto &entry : entries) {
-      if (auto conn = entry.conn(); conn) {
-        conn->deleter = nullptr;
-      }
-    }
   }
 
-  constexpr BasicSignal(const BasicSignal &rhs) noexcept : BasicSignal()
+  static void destroy(ConnectionBase *base) noexcept
   {
-    Lock lock1(entriesMutex);
-    Lock lock2(rhs.entriesMutex);
-    entries = rhs.entries;
+    auto *self = static_cast<Allocated *>(base);
+    typename Traits::allocator_type rebound(self->allocator);
+    Traits::destroy(rebound, self);
+    Traits::deallocate(rebound, self, 1);
+  }
 
-    // `atomic_bool` can't be copied, so copy value.
-    blocked_ = rhs.blocked_.load();
+  [[no_unique_address]] Allocator allocator;
+};
+
+/// Handle of a connection returned when connecting a slot.
+/** It's a single pointer to the intrusively reference-counted ConnectionBase, whose storage is
+    freed as soon as the slot is disconnected and no handle is left. */
+class Connection final {
+  template <typename, typename, typename>
+  friend class BasicSignal;
+
+public:
+  Connection() noexcept = default;
+
+  Connection(std::nullptr_t) noexcept
+  {
   }
 
-  constexpr BasicSignal &operator=(const BasicSignal &rhs) noexcept
+  ~Connection() noexcept
   {
-    Lock lock1(entriesMutex);
-    Lock lock2(rhs.entriesMutex);
-    entries = rhs.entries;
-    blocked_ = rhs.blocked_.load();
-    return *this;
+    release();
   }
 
-  constexpr BasicSignal(BasicSignal &&rhs) noexcept = default;
-  constexpr BasicSignal &operator=(BasicSignal &&rhs) noexcept = default;
+  Connection(const Connection &rhs) noexcept : base(rhs.base)
+  {
+    if (base) {
+      base->retain();
+    }
+  }
 
-  constexpr std::size_t size() const noexcept
+  Connection(Connection &&rhs) noexcept : base(std::exchange(rhs.base, nullptr))
   {
-    Lock lock(entriesMutex);
-    return std::size(entries);
   }
 
-  constexpr bool empty() const noexcept
+  Connection &operator=(const Connection &rhs) noexcept
   {
-    return 0 == size();
+    Connection copy(rhs);
+    std::swap(base, copy.base);
+    return *this;
   }
 
-  Connection connect(const Slot &slot) noexcept
+  Connection &operator=(Connection &&rhs) noexcept
   {
-    Lock lock(entriesMutex);
-    auto conn = makeConnection();
-    entries.emplace_back(Entry(slot, conn));
-    return conn;
+    if (this != &rhs) {
+      release();
+      base = std::exchange(rhs.base, nullptr);
+    }
+    return *this;
   }
 
-  Connection connect(Slot &&slot) noexcept
+  [[nodiscard]] ConnectionBase *get() const noexcept
   {
-    Lock lock(entriesMutex);
-    auto conn = makeConnection();
-    entries.emplace_back(Entry(std::move(slot), conn));
-    return conn;
+    return base;
   }
 
-  template <typename Instance, typename MembFunc>
-  Connection connect(Instance *instance, MembFunc Instance::*mf) noexcept
+  ConnectionBase *operator->() const noexcept
   {
-    Lock lock(entriesMutex);
-    auto slot = bindMf(instance, mf);
-    auto conn = makeConnection();
-    entries.emplace_back(Entry(slot, conn));
-    return conn;
+    return base;
   }
 
-  /// Connecting a signal will trigger all of its slots when this signal is triggered.
-  Connection connect(BasicSignal &signal) noexcept
+  ConnectionBase &operator*() const noexcept
   {
-    Lock lock(entriesMutex);
-    auto conn = makeConnection();
-    entries.emplace_back(Entry(&signal, conn));
-    return conn;
+    return *base;
   }
 
-  constexpr void clear() noexcept
+  explicit operator bool() const noexcept
   {
-    Lock lock(entriesMutex);
-    eraseEntries();
+    return base != nullptr;
+  }
+
+  friend bool operator==(const Connection &lhs, const Connection &rhs) noexcept = default;
+
+private:
+  /// Takes over the reference of a new connection.
+  explicit Connection(ConnectionBase *base_) noexcept : base(base_)
+  {
+  }
+
+  void release() noexcept
+  {
+    if (base && base->release()) {
+      base->destroy(base);
+    }
+  }
+
+  ConnectionBase *base = nullptr;
+};
+
+/// Connection that is disconnected when destroyed or assigned.
+/** It holds nothing but the Connection itself.
+
+    Example:
+      sigs::ScopedConnection conn = signal.connect([] {});
+    */
+class ScopedConnection final {
+public:
+  ScopedConnection() noexcept = default;
+
+  ScopedConnection(Connection conn_) noexcept : conn(std::move(conn_))
+  {
+  }
+
+  ~ScopedConnection() noexcept
+  {
+    disconnect();
+  }
+
+  ScopedConnection(const ScopedConnection &) = delete;
+  ScopedConnection &operator=(const ScopedConnection &) = delete;
+
+  ScopedConnection(ScopedConnection &&rhs) noexcept = default;
+
+  ScopedConnection &operator=(ScopedConnection &&rhs) noexcept
+  {
+    if (this != &rhs) {
+      disconnect();
+      conn = std::move(rhs.conn);
+    }
+    return *this;
+  }
+
+  void disconnect() noexcept
+  {
+    if (conn) {
+      conn->disconnect();
+      conn = nullptr;
+    }
+  }
+
+  /// Returns the connection without disconnecting it.
+  [[nodiscard]] Connection release() noexcept
+  {
+    return std::move(conn);
+  }
+
+  [[nodiscard]] const Connection &get() const noexcept
+  {
+    return conn;
+  }
+
+  explicit operator bool() const noexcept
+  {
+    return static_cast<bool>(conn);
+  }
+
+private:
+  Connection conn;
+};
+
+/// Connections that are disconnected together when destroyed or when calling disconnect().
+/** Disconnecting takes the lock of each signal only once for all of its connections in the set,
+    instead of once per connection. Like the standard containers, a set must not be modified by
+    multiple threads at the same time. */
+class ConnectionSet final {
+public:
+  ConnectionSet() noexcept = default;
+
+  ~ConnectionSet() noexcept
+  {
+    disconnect();
+  }
+
+  ConnectionSet(const ConnectionSet &) = delete;
+  ConnectionSet &operator=(const ConnectionSet &) = delete;
+
+  ConnectionSet(ConnectionSet &&rhs) noexcept = default;
+
+  ConnectionSet &operator=(ConnectionSet &&rhs) noexcept
+  {
+    if (this != &rhs) {
+      disconnect();
+      conns = std::move(rhs.conns);
+    }
+    return *this;
+  }
+
+  void add(Connection conn) noexcept
+  {
+    conns.emplace_back(std::move(conn));
+  }
+
+  ConnectionSet &operator+=(Connection conn) noexcept
+  {
+    add(std::move(conn));
+    return *this;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return std::size(conns);
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return conns.empty();
+  }
+
+  /// Disconnects all connections of the set, grouped by signal, and removes them from the set.
+  void disconnect() noexcept
+  {
+    // The signal of each connection is loaded once, since it's reset if disconnected meanwhile.
+    std::vector<std::pair<void *, const ConnectionBase *>> pending;
+    pending.reserve(size());
+    for (const auto &conn : conns) {
+      if (auto *sig = conn ? conn->loadSignal(std::memory_order_acquire) : nullptr; sig) {
+        pending.emplace_back(sig, conn.get());
+      }
+    }
+    // std::less orders unrelated pointers, unlike the built-in comparison.
+    std::sort(pending.begin(), pending.end(), [](const auto &lhs, const auto &rhs) {
+      if (lhs.first != rhs.first) return std::less<>()(lhs.first, rhs.first);
+      return std::less<>()(lhs.second, rhs.second);
+    });
+
+    std::vector<const ConnectionBase *> group;
+    for (std::size_t i = 0; i < std::size(pending);) {
+      auto *sig = pending[i].first;
+      const auto disconnectFrom = pending[i].second->disconnectFrom;
+      group.clear();
+      for (; i < std::size(pending) && pending[i].first == sig; ++i) {
+        group.emplace_back(pending[i].second);
+      }
+      disconnectFrom(sig, group);
+    }
+    conns.clear();
+  }
+
+private:
+  std::vector<Connection> conns;
+};
+
+namespace detail {
+
+/// VoidableFunction is used internally to generate a function type depending on whether the return
+/// type of the signal is non-void.
+template <typename T>
+class VoidableFunction final {
+public:
+  using func = std::function<void(T)>;
+};
+
+/// Specialization for void return types.
+template <>
+class VoidableFunction<void> final {
+public:
+  using func = std::function<void()>;
+};
+
+/// Stop condition of emissions that invoke all entries.
+class NeverStop final {
+public:
+  constexpr bool operator()() const noexcept
+  {
+    return false;
+  }
+};
+
+/// Atomic flag that can be raised concurrently and copied along with its value.
+class Flag final {
+public:
+  Flag() noexcept = default;
+
+  Flag(const Flag &rhs) noexcept : value(rhs.value.load(std::memory_order_relaxed))
+  {
+  }
+
+  Flag &operator=(const Flag &rhs) noexcept
+  {
+    value.store(rhs.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
+
+  /// Only writes if it isn't raised yet, so raising it repeatedly from several threads doesn't
+  /// contend on the cache line.
+  void raise() noexcept
+  {
+    if (!value.load(std::memory_order_relaxed)) {
+      value.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  /// Returns whether it was raised.
+  bool lower() noexcept
+  {
+    return value.exchange(false, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic_bool value = false;
+};
+
+/// Variable with the interface of `std::atomic` that isn't synchronized at all, for signals used
+/// by a single thread, see DefaultPolicy::threadSafe. Memory orders are ignored.
+template <typename T>
+class Unsynchronized final {
+public:
+  constexpr Unsynchronized(T value_ = T()) noexcept : value(value_)
+  {
+  }
+
+  constexpr Unsynchronized &operator=(T desired) noexcept
+  {
+    value = desired;
+    return *this;
+  }
+
+  constexpr operator T() const noexcept
+  {
+    return value;
+  }
+
+  [[nodiscard]] constexpr T load(std::memory_order /*unused*/ = {}) const noexcept
+  {
+    return value;
+  }
+
+  constexpr void store(T desired, std::memory_order /*unused*/ = {}) noexcept
+  {
+    value = desired;
+  }
+
+  constexpr T exchange(T desired, std::memory_order /*unused*/ = {}) noexcept
+  {
+    return std::exchange(value, desired);
+  }
+
+  constexpr T fetch_add(T arg, std::memory_order /*unused*/ = {}) noexcept
+  {
+    return std::exchange(value, value + arg);
+  }
+
+  constexpr bool compare_exchange_weak(T &expected, T desired, std::memory_order /*unused*/ = {},
+                                       std::memory_order /*unused*/ = {}) noexcept
+  {
+    if (value != expected) {
+      expected = value;
+      return false;
+    }
+    value = desired;
+    return true;
+  }
+
+private:
+  T value;
+};
+
+/// `std::atomic<T>` if \p threadSafe, or Unsynchronized otherwise.
+template <typename T, bool threadSafe>
+using Atomic = std::conditional_t<threadSafe, std::atomic<T>, Unsynchronized<T>>;
+
+/// Epoch-based reclamation shared by all signals using Emission::Epoch.
+/** Every thread inside a read-side section announces the global epoch it observed when entering in
+    its own record. Memory unlinked before advance() returned a target epoch can be freed once
+    oldest() reaches that target, without waiting for anyone. synchronize() advances the global
+    epoch and waits until no other thread is inside a section that was entered before that. Each
+    section also announces the signal whose slots it's invoking, so waiting for the emissions of a
+    single signal skips the threads emitting other ones. */
+class EpochDomain final {
+  struct alignas(64) Record final {
+    /// Number of nesting levels whose signals are announced, deeper ones are taken to read any.
+    static constexpr std::size_t maxSignals = 8;
+
+    /// Whether a section entered before \p target may still be invoking slots of \p signal.
+    [[nodiscard]] bool reads(const void *signal, std::uint64_t target) const noexcept
+    {
+      if (const auto observed = epoch.load(); observed == 0 || observed >= target) return false;
+
+      const auto levels = nesting.load();
+      if (levels > maxSignals) return true;
+
+      for (std::size_t level = 0; level < levels; ++level) {
+        if (signals[level].load() == signal) return true;
+      }
+      return false;
+    }
+
+    /// Epoch observed when entering the outermost read-side section, or zero when outside.
+    std::atomic_uint64_t epoch = 0;
+
+    std::atomic_bool used = true;
+    Record *next = nullptr;
+
+    /// Only written by the owning thread.
+    std::atomic_size_t nesting = 0;
+
+    /// Signal announced by the section at each nesting level.
+    std::array<std::atomic<const void *>, maxSignals> signals{};
+  };
+
+  /// Releases the record of a thread for reuse when the thread exits.
+  class ThreadRecord final {
+  public:
+    ThreadRecord() noexcept = default;
+
+    ~ThreadRecord() noexcept
+    {
+      if (record) {
+        record->used.store(false, std::memory_order_release);
+      }
+    }
+
+    ThreadRecord(const ThreadRecord &) = delete;
+    ThreadRecord &operator=(const ThreadRecord &) = delete;
+
+    Record *record = nullptr;
+  };
+
+public:
+  /// Read-side section of the calling thread, which may be nested, invoking slots of \p signal.
+  /** The signal and the nesting level are announced before the epoch, so a thread waiting in
+      synchronize() after unpublishing entries either sees the announcement or the section loads
+      the newly published entries. */
+  class Guard final {
+  public:
+    explicit Guard(const void *signal) noexcept
+      : record(instance().acquire()), level(record->nesting.load(std::memory_order_relaxed))
+    {
+      announce(signal);
+      record->nesting.store(level + 1);
+      if (level == 0) {
+        record->epoch.store(instance().epoch.load());
+      }
+    }
+
+    ~Guard() noexcept
+    {
+      if (level == 0) {
+        record->epoch.store(0, std::memory_order_release);
+      }
+      record->nesting.store(level, std::memory_order_release);
+    }
+
+    Guard(const Guard &) = delete;
+    Guard &operator=(const Guard &) = delete;
+
+    /// Announces that the section invokes slots of \p signal from now on instead.
+    void announce(const void *signal) noexcept
+    {
+      if (level < Record::maxSignals) {
+        record->signals[level].store(signal);
+      }
+    }
+
+  private:
+    Record *record;
+    std::size_t level;
+  };
+
+  [[nodiscard]] static EpochDomain &instance() noexcept
+  {
+    static EpochDomain domain;
+    return domain;
+  }
+
+  /// Whether the calling thread is inside a read-side section.
+  [[nodiscard]] static bool reading() noexcept
+  {
+    const auto *record = threadRecord().record;
+    return record && record->nesting.load(std::memory_order_relaxed) > 0;
+  }
+
+  /// Advances the global epoch and returns the new one, which read-side sections entered from now
+  /// on observe.
+  [[nodiscard]] std::uint64_t advance() noexcept
+  {
+    return epoch.fetch_add(1) + 1;
+  }
+
+  /// Returns the oldest epoch any thread, including the calling one, may still be reading in.
+  /** Memory retired with a target epoch up to the returned one isn't reachable by any read-side
+      section anymore. */
+  [[nodiscard]] std::uint64_t oldest() const noexcept
+  {
+    auto result = epoch.load();
+    for (auto *record = records.load(std::memory_order_acquire); record; record = record->next) {
+      if (const auto observed = record->epoch.load(); observed != 0 && observed < result) {
+        result = observed;
+      }
+    }
+    return result;
+  }
+
+  /// Waits until all read-side sections of other threads that were entered before the call have
+  /// been left.
+  void synchronize() noexcept
+  {
+    const auto target = advance();
+    const auto *self = threadRecord().record;
+    for (auto *record = records.load(std::memory_order_acquire); record; record = record->next) {
+      if (record == self) continue;
+
+      for (auto observed = record->epoch.load(); observed != 0 && observed < target;
+           observed = record->epoch.load()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /// Like above but only waits for the sections that announced \p signal, see Guard.
+  void synchronize(const void *signal) noexcept
+  {
+    const auto target = advance();
+    const auto *self = threadRecord().record;
+    for (auto *record = records.load(std::memory_order_acquire); record; record = record->next) {
+      if (record == self) continue;
+
+      while (record->reads(signal, target)) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+private:
+  EpochDomain() noexcept = default;
+
+  [[nodiscard]] static ThreadRecord &threadRecord() noexcept
+  {
+    thread_local ThreadRecord local;
+    return local;
+  }
+
+  /// Records are never freed but reused after their threads have exited.
+  [[nodiscard]] Record *acquire() noexcept
+  {
+    auto &local = threadRecord();
+    if (local.record) return local.record;
+
+    for (auto *record = records.load(std::memory_order_acquire); record; record = record->next) {
+      if (bool expected = false;
+          record->used.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        local.record = record;
+        return record;
+      }
+    }
+
+    auto *record = new Record;
+    record->next = records.load(std::memory_order_relaxed);
+    while (!records.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+    }
+    local.record = record;
+    return record;
+  }
+
+  std::atomic_uint64_t epoch = 1;
+  std::atomic<Record *> records = nullptr;
+};
+
+/// Mutex that can also be locked shared, like `std::shared_mutex`.
+template <typename Mutex>
+concept SharedLockable = requires(Mutex &mutex) {
+  mutex.lock_shared();
+  mutex.try_lock_shared();
+  mutex.unlock_shared();
+};
+
+/// Signals with shared locked emission that the calling thread is emitting, innermost last.
+[[nodiscard]] inline std::vector<const void *> &emittingSignals() noexcept
+{
+  thread_local std::vector<const void *> signals;
+  return signals;
+}
+
+/// Guards the signals each signal is connected to, so that concurrent connections can't close a
+/// cycle. It's never held while waiting for anything else.
+[[nodiscard]] inline std::mutex &signalGraphMutex() noexcept
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// Used to detect whether a type is, or extends, a BasicSignal or a StaticSignal.
+//@{
+
+template <typename RetArgs, typename Lock, typename Policy>
+std::true_type isSignal(const BasicSignal<RetArgs, Lock, Policy> *);
+
+template <typename RetArgs, auto... Slots>
+std::true_type isSignal(const StaticSignal<RetArgs, Slots...> *);
+
+std::false_type isSignal(const void *);
+
+//@}
+
+} // namespace detail
+
+template <typename Sig>
+class SignalBlocker {
+  static_assert(decltype(detail::isSignal(std::declval<Sig *>()))::value,
+                "Sig must extend sigs::BasicSignal or sigs::StaticSignal");
+
+public:
+  explicit constexpr SignalBlocker(Sig *sig) noexcept : sig_(sig)
+  {
+    reblock();
+  }
+
+  explicit constexpr SignalBlocker(Sig &sig) noexcept : sig_(&sig)
+  {
+    reblock();
+  }
+
+  virtual constexpr ~SignalBlocker() noexcept
+  {
+    unblock();
+  }
+
+  constexpr SignalBlocker(const SignalBlocker &rhs) = delete;
+  constexpr SignalBlocker &operator=(const SignalBlocker &rhs) = delete;
+
+  constexpr SignalBlocker(SignalBlocker &&rhs) noexcept
+  {
+    moveAssign(std::move(rhs));
+  }
+
+  /// Unblocks `this` if signals of `this` and `rhs` aren't the same.
+  constexpr SignalBlocker &operator=(SignalBlocker &&rhs) noexcept
+  {
+    if (sig_ != rhs.sig_) {
+      unblock();
+    }
+
+    moveAssign(std::move(rhs));
+    return *this;
+  }
+
+  constexpr void reblock() noexcept
+  {
+    if (sig_) {
+      previous = sig_->setBlocked(true);
+    }
+  }
+
+  constexpr void unblock() noexcept
+  {
+    if (sig_) {
+      sig_->setBlocked(previous);
+    }
+  }
+
+private:
+  constexpr void moveAssign(SignalBlocker &&rhs)
+  {
+    sig_ = rhs.sig_;
+    previous = rhs.previous;
+
+    // `rhs` won't do any action on destruction.
+    rhs.sig_ = nullptr;
+  }
+
+  Sig *sig_ = nullptr;
+  bool previous = false;
+};
+
+/// Suppress CTAD warning.
+template <typename Sig>
+SignalBlocker(Sig) -> SignalBlocker<Sig>;
+
+/// Receives the events of queued connections and invokes their slots when drained.
+/** Slots connected to a signal via BasicSignal::connect(EventLoop &, Slot) aren't invoked by the
+    emitting thread. Instead each emission queues an event, holding the arguments, on the loop and
+    the thread that owns the loop invokes the slots by calling drain(). Any number of threads may
+    queue events concurrently, without taking a lock, but only one thread at a time may drain.
+
+    Example:
+      sigs::EventLoop loop;
+      signal.connect(loop, [](int value) { .. });
+      signal(42); // From any thread.
+      loop.drain(); // Invokes the slot on this thread.
+    */
+class EventLoop final {
+public:
+  /// Event queued on the loop, see BasicSignal::connect(EventLoop &, Slot).
+  class Event {
+  public:
+    /// Runs the event if \p run is true and releases it.
+    using Deliver = void (*)(Event &, bool run);
+
+    explicit Event(Deliver deliver_ = nullptr) noexcept : deliver(deliver_)
+    {
+    }
+
+    std::atomic<Event *> next = nullptr;
+    Deliver deliver = nullptr;
+  };
+
+  /// \p wakeup is called after each queued event, for instance to wake the thread owning the loop.
+  /** It is called by the thread emitting the signal and must be thread-safe. */
+  explicit EventLoop(std::function<void()> wakeup = nullptr) noexcept : wakeup_(std::move(wakeup))
+  {
+  }
+
+  /// Releases the remaining events without running them.
+  ~EventLoop() noexcept
+  {
+    while (auto *event = pop()) {
+      event->deliver(*event, false);
+    }
+  }
+
+  EventLoop(const EventLoop &) = delete;
+  EventLoop &operator=(const EventLoop &) = delete;
+
+  /// Queues \p event, which may be called from any thread.
+  void post(Event &event) noexcept
+  {
+    push(event);
+    if (wakeup_) {
+      wakeup_();
+    }
+  }
+
+  /// Runs up to \p max queued events in the order they were queued and returns how many ran.
+  /** Events queued by the slots themselves are run by the same call as long as \p max isn't
+      reached. */
+  std::size_t drain(std::size_t max = std::numeric_limits<std::size_t>::max()) noexcept
+  {
+    std::size_t count = 0;
+    for (; count < max; ++count) {
+      auto *event = pop();
+      if (!event) break;
+      event->deliver(*event, true);
+    }
+    return count;
+  }
+
+private:
+  void push(Event &event) noexcept
+  {
+    event.next.store(nullptr, std::memory_order_relaxed);
+    auto *previous = head.exchange(&event, std::memory_order_acq_rel);
+    previous->next.store(&event, std::memory_order_release);
+  }
+
+  /// Dequeues the oldest event, or returns null if none is queued or the oldest one is still being
+  /// queued.
+  /** Implements the intrusive multi-producer/single-consumer queue by Dmitry Vyukov, where
+      producers only exchange the head and the consumer owns the tail. The stub event keeps the
+      queue non-empty so that producers never touch the tail. */
+  [[nodiscard]] Event *pop() noexcept
+  {
+    auto *first = tail;
+    auto *next = first->next.load(std::memory_order_acquire);
+    if (first == &stub) {
+      if (!next) return nullptr;
+      tail = next;
+      first = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+      tail = next;
+      return first;
+    }
+    if (first != head.load(std::memory_order_acquire)) return nullptr;
+
+    push(stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next) {
+      tail = next;
+      return first;
+    }
+    return nullptr;
+  }
+
+  Event stub;
+  std::atomic<Event *> head = &stub;
+  Event *tail = &stub;
+  std::function<void()> wakeup_;
+};
+
+namespace detail {
+
+/// Fixed number of preallocated nodes that can be acquired and released from any thread without
+/// taking a lock.
+/** The free nodes form a stack linked by index. Its head packs the index of the top node with a
+    tag that is incremented on each change, so a thread whose view of the top node is outdated can't
+    succeed in swapping the head. `Node` must have an `std::atomic_uint32_t nextFree` member. The
+    nodes are allocated with \p Allocator. */
+template <typename Node, typename Allocator = std::allocator<Node>>
+class NodePool final {
+  using Traits = typename std::allocator_traits<Allocator>::template rebind_traits<Node>;
+
+public:
+  explicit NodePool(std::size_t capacity, const Allocator &allocator_ = Allocator()) noexcept
+    : allocator(allocator_), capacity_(static_cast<std::uint32_t>(capacity))
+  {
+    assert(capacity < none && "Pool capacity too large.");
+    if (capacity_ > 0) {
+      nodes = Traits::allocate(allocator, capacity_);
+    }
+    for (std::uint32_t i = 0; i < capacity_; ++i) {
+      Traits::construct(allocator, nodes + i);
+      nodes[i].nextFree.store(i + 1 < capacity_ ? i + 1 : none, std::memory_order_relaxed);
+    }
+    head.store(pack(capacity_ > 0 ? 0 : none, 0), std::memory_order_relaxed);
+  }
+
+  ~NodePool() noexcept
+  {
+    if (!nodes) return;
+
+    for (std::uint32_t i = 0; i < capacity_; ++i) {
+      Traits::destroy(allocator, nodes + i);
+    }
+    Traits::deallocate(allocator, nodes, capacity_);
+  }
+
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+
+  /// Returns a free node, or null if all of them are in use.
+  [[nodiscard]] Node *acquire() noexcept
+  {
+    auto top = head.load(std::memory_order_acquire);
+    for (;;) {
+      const auto index = indexOf(top);
+      if (index == none) return nullptr;
+
+      const auto next = nodes[index].nextFree.load(std::memory_order_relaxed);
+      if (head.compare_exchange_weak(top, pack(next, tagOf(top) + 1), std::memory_order_acquire,
+                                     std::memory_order_acquire)) {
+        return &nodes[index];
+      }
+    }
+  }
+
+  /// Returns \p node, which must be owned by the pool, to it.
+  void release(Node *node) noexcept
+  {
+    const auto index = static_cast<std::uint32_t>(node - nodes);
+    auto top = head.load(std::memory_order_relaxed);
+    do {
+      node->nextFree.store(indexOf(top), std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(top, pack(index, tagOf(top) + 1),
+                                         std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  [[nodiscard]] bool owns(const Node *node) const noexcept
+  {
+    return capacity_ > 0 && node >= nodes && node < nodes + capacity_;
+  }
+
+private:
+  static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+  static constexpr std::uint64_t pack(std::uint32_t index, std::uint32_t tag) noexcept
+  {
+    return (static_cast<std::uint64_t>(tag) << 32) | index;
+  }
+
+  static constexpr std::uint32_t indexOf(std::uint64_t top) noexcept
+  {
+    return static_cast<std::uint32_t>(top);
+  }
+
+  static constexpr std::uint32_t tagOf(std::uint64_t top) noexcept
+  {
+    return static_cast<std::uint32_t>(top >> 32);
+  }
+
+  [[no_unique_address]] typename Traits::allocator_type allocator;
+  Node *nodes = nullptr;
+  std::uint32_t capacity_ = 0;
+  std::atomic_uint64_t head = pack(none, 0);
+};
+
+} // namespace detail
+
+/// Runs tasks for BasicSignal::emitParallel().
+/** `concurrency()` is the number of tasks it can run at the same time, besides the calling
+    thread. */
+template <typename Exec>
+concept Executor = requires(Exec &executor, std::function<void()> task) {
+  executor.execute(std::move(task));
+  { executor.concurrency() } -> std::convertible_to<std::size_t>;
+};
+
+/// Fixed number of worker threads running tasks in submission order, see Executor.
+class ThreadPool final {
+public:
+  /// Starts \p threads workers. If \p cpus isn't empty, worker `i` is pinned to CPU
+  /// `cpus[i % cpus.size()]`, which is only supported on Linux and ignored elsewhere.
+  explicit ThreadPool(std::size_t threads, const std::vector<int> &cpus = {}) noexcept
+  {
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      auto &worker = workers.emplace_back([this] { run(); });
+      if (!cpus.empty()) {
+        pin(worker, cpus[i % cpus.size()]);
+      }
+    }
+  }
+
+  ~ThreadPool() noexcept
+  {
+    {
+      std::scoped_lock lock(tasksMutex);
+      stopping = true;
+    }
+    tasksCondition.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  void execute(std::function<void()> task) noexcept
+  {
+    {
+      std::scoped_lock lock(tasksMutex);
+      tasks.emplace_back(std::move(task));
+    }
+    tasksCondition.notify_one();
+  }
+
+  [[nodiscard]] std::size_t concurrency() const noexcept
+  {
+    return std::size(workers);
+  }
+
+private:
+  void run() noexcept
+  {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock lock(tasksMutex);
+        tasksCondition.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty()) return;
+
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  static void pin([[maybe_unused]] std::thread &thread, [[maybe_unused]] int cpu) noexcept
+  {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#endif
+  }
+
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> tasks;
+  std::mutex tasksMutex;
+  std::condition_variable tasksCondition;
+  bool stopping = false;
+};
+
+/// Combines the return values of the slots for BasicSignal::emit().
+/** The combiner is invoked with each return value in connection order, and `result()` yields the
+    value returned by the emission. If it has `reserve(std::size_t)`, that is called with the number
+    of slots before emitting. If it has `done()`, the emission stops as soon as that returns
+    true. */
+template <typename Comb, typename T>
+concept Combiner = requires(Comb combiner, T value) {
+  combiner(std::forward<T>(value));
+  std::move(combiner).result();
+};
+
+/// Common combiners for BasicSignal::emit().
+namespace collect {
+
+/// Sum of all return values, or a value-initialized `T` if no slot was invoked.
+template <typename T>
+class Sum final {
+public:
+  constexpr void operator()(const T &value) noexcept
+  {
+    sum += value;
+  }
+
+  [[nodiscard]] constexpr std::remove_cvref_t<T> result() noexcept
+  {
+    return std::move(sum);
+  }
+
+private:
+  std::remove_cvref_t<T> sum{};
+};
+
+/// Largest return value, or no value if no slot was invoked.
+template <typename T>
+class Max final {
+public:
+  constexpr void operator()(T value) noexcept
+  {
+    if (!max || *max < value) {
+      max = std::forward<T>(value);
+    }
+  }
+
+  [[nodiscard]] constexpr std::optional<std::remove_cvref_t<T>> result() noexcept
+  {
+    return std::move(max);
+  }
+
+private:
+  std::optional<std::remove_cvref_t<T>> max;
+};
+
+/// Return value of the last slot, or no value if no slot was invoked.
+template <typename T>
+class Last final {
+public:
+  constexpr void operator()(T value) noexcept
+  {
+    last = std::forward<T>(value);
+  }
+
+  [[nodiscard]] constexpr std::optional<std::remove_cvref_t<T>> result() noexcept
+  {
+    return std::move(last);
+  }
+
+private:
+  std::optional<std::remove_cvref_t<T>> last;
+};
+
+/// All return values in connection order.
+template <typename T>
+class ToVector final {
+public:
+  void reserve(std::size_t count) noexcept
+  {
+    values.reserve(count);
+  }
+
+  void operator()(T value) noexcept
+  {
+    values.emplace_back(std::forward<T>(value));
+  }
+
+  [[nodiscard]] std::vector<std::remove_cvref_t<T>> result() noexcept
+  {
+    return std::move(values);
+  }
+
+private:
+  std::vector<std::remove_cvref_t<T>> values;
+};
+
+/// First return value that converts to `true`, like a non-null pointer or an engaged optional, or
+/// a value-initialized `T` if there is none. No more slots are invoked once it's found.
+template <typename T>
+class FirstNonNull final {
+public:
+  constexpr void operator()(T value) noexcept
+  {
+    if (!found && static_cast<bool>(value)) {
+      first = std::forward<T>(value);
+      found = true;
+    }
+  }
+
+  [[nodiscard]] constexpr bool done() const noexcept
+  {
+    return found;
+  }
+
+  [[nodiscard]] constexpr std::remove_cvref_t<T> result() noexcept
+  {
+    return std::move(first);
+  }
+
+private:
+  std::remove_cvref_t<T> first{};
+  bool found = false;
+};
+
+/// Whether any slot returned `true`. No more slots are invoked once one does, like for the first
+/// handler accepting an event.
+template <typename T>
+class AnyOf final {
+public:
+  constexpr void operator()(const T &value) noexcept
+  {
+    any = any || static_cast<bool>(value);
+  }
+
+  [[nodiscard]] constexpr bool done() const noexcept
+  {
+    return any;
+  }
+
+  [[nodiscard]] constexpr bool result() const noexcept
+  {
+    return any;
+  }
+
+private:
+  bool any = false;
+};
+
+/// Whether all slots returned `true`, which is the case if there are none. No more slots are
+/// invoked once one returns `false`, like for a chain of validators.
+template <typename T>
+class AllOf final {
+public:
+  constexpr void operator()(const T &value) noexcept
+  {
+    all = all && static_cast<bool>(value);
+  }
+
+  [[nodiscard]] constexpr bool done() const noexcept
+  {
+    return !all;
+  }
+
+  [[nodiscard]] constexpr bool result() const noexcept
+  {
+    return all;
+  }
+
+private:
+  bool all = true;
+};
+
+} // namespace collect
+
+template <typename Ret, typename... Args, typename Lock, typename Policy>
+class BasicSignal<Ret(Args...), Lock, Policy> {
+public:
+  using RetArgs = Ret(Args...);
+  using SignalType = BasicSignal<RetArgs, Lock, Policy>;
+  using LockType = Lock;
+  using PolicyType = Policy;
+  using ReturnType = Ret;
+  using AllocatorType = typename Policy::Allocator;
+
+  /// Events passed to emitBatch().
+  using Batch = std::span<const std::tuple<Args...>>;
+
+  /// Slot taking a whole batch of events, see connectBatch().
+  using BatchSlot = Delegate<void(Batch), Policy::slotCapacity, AllocatorType>;
+
+private:
+  using Allocator = AllocatorType;
+  using Slot = Delegate<RetArgs, Policy::slotCapacity, Allocator>;
+  using Function = Ret (*)(Args...);
+  using Mutex = typename Lock::mutex_type;
+
+  /// Lock taken by emissions and the other paths that only read the entries, which is shared if
+  /// the mutex supports it so that they don't serialize each other.
+  using ReadLock = std::conditional_t<detail::SharedLockable<Mutex>, std::shared_lock<Mutex>, Lock>;
+
+  /// Object whose lifetime bounds a tracked slot, see connect(std::weak_ptr<T>, Slot).
+  using Tracker = std::weak_ptr<const void>;
+
+  template <typename T>
+  using Vector =
+    std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+  template <typename T>
+  using AllocatorTraits =
+    typename std::allocator_traits<Allocator>::template rebind_traits<std::remove_const_t<T>>;
+
+  /// Destroys and deallocates objects created by makeUnique().
+  class Deleter final {
+  public:
+    template <typename T>
+    void operator()(T *ptr) const noexcept
+    {
+      typename AllocatorTraits<T>::allocator_type rebound(allocator);
+      auto *object = const_cast<std::remove_const_t<T> *>(ptr);
+      AllocatorTraits<T>::destroy(rebound, object);
+      AllocatorTraits<T>::deallocate(rebound, object, 1);
+    }
+
+    [[no_unique_address]] Allocator allocator;
+  };
+
+  template <typename T>
+  using UniquePtr = std::unique_ptr<T, Deleter>;
+
+  /// Creates a `T` from \p args with \p allocator, like `std::make_unique()`.
+  template <typename T, typename... TArgs>
+  [[nodiscard]] static UniquePtr<T> makeUnique(const Allocator &allocator, TArgs &&...args) noexcept
+  {
+    typename AllocatorTraits<T>::allocator_type rebound(allocator);
+    auto *object = AllocatorTraits<T>::allocate(rebound, 1);
+    AllocatorTraits<T>::construct(rebound, object, std::forward<TArgs>(args)...);
+    return UniquePtr<T>(object, Deleter{allocator});
+  }
+
+  /// Entries in connection order.
+  /** Stored as a structure of arrays, so emission only touches the callables while the connection
+      bookkeeping, which is only needed for modifications, is kept apart.
+
+      The entries form a slot map: each connection is keyed by an id and the generation of that id,
+      which locate its entry in constant time. Erasing an entry leaves an empty entry behind instead
+      of moving the following ones, and emission skips it. The empty entries are compacted once
+      they make up more than a quarter of the arrays, so erasing is amortized constant time while
+      the arrays stay dense.
+
+      Entries of tracked slots whose object is gone are skipped by emission as well, which flags
+      the container so they are erased by its next modification.
+
+      All arrays allocate with the allocator of the signal, and copies keep allocating with the
+      allocator of the copied container unless another one is given. */
+  class Cont final {
+  public:
+    static constexpr auto npos = std::numeric_limits<std::size_t>::max();
+
+    Cont() noexcept = default;
+
+    explicit Cont(const Allocator &allocator) noexcept
+      : functions(allocator), slots(allocator), signals(allocator), batchSlots(allocator),
+        trackers(allocator), conns(allocator), ids(allocator), keys(allocator), freeIds(allocator)
+    {
+    }
+
+    Cont(const Cont &rhs) noexcept : Cont(rhs, rhs.allocator())
+    {
+    }
+
+    /// Copies \p rhs, including its slots stored on the heap, with \p allocator.
+    Cont(const Cont &rhs, const Allocator &allocator) noexcept
+      : functions(rhs.functions, allocator), slots(allocator), signals(rhs.signals, allocator),
+        batchSlots(rhs.batchSlots, allocator), trackers(rhs.trackers, allocator),
+        conns(rhs.conns, allocator), signalCount(rhs.signalCount),
+        expiredTrackers(rhs.expiredTrackers), ids(rhs.ids, allocator), keys(rhs.keys, allocator),
+        freeIds(rhs.freeIds, allocator), erased(rhs.erased)
+    {
+      slots.reserve(rhs.slots.size());
+      for (const auto &slot : rhs.slots) {
+        slots.emplace_back(slot, allocator);
+      }
+    }
+
+    Cont(Cont &&rhs) noexcept = default;
+
+    /// Keeps allocating with the allocator of this container.
+    Cont &operator=(const Cont &rhs) noexcept
+    {
+      return *this = Cont(rhs, allocator());
+    }
+
+    Cont &operator=(Cont &&rhs) noexcept = default;
+
+    [[nodiscard]] Allocator allocator() const noexcept
+    {
+      return Allocator(conns.get_allocator());
+    }
+
+    /// Number of entries including erased ones, which bounds the indices of the arrays.
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+      return std::size(conns);
+    }
+
+    /// Number of entries that aren't erased.
+    [[nodiscard]] std::size_t connectedCount() const noexcept
+    {
+      return size() - erased;
+    }
+
+    /// Reserves room for \p count entries.
+    void reserve(std::size_t count) noexcept
+    {
+      functions.reserve(count);
+      slots.reserve(count);
+      signals.reserve(count);
+      batchSlots.reserve(count);
+      trackers.reserve(count);
+      conns.reserve(count);
+      ids.reserve(count);
+    }
+
+    void add(Connection conn, Function function, Slot &&slot, BasicSignal *signal,
+             const BatchSlot *batchSlot, const Tracker *tracker) noexcept
+    {
+      if (signal) {
+        ++signalCount;
+      }
+
+      std::size_t id = std::size(keys);
+      if (freeIds.empty()) {
+        keys.emplace_back();
+      }
+      else {
+        id = freeIds.back();
+        freeIds.pop_back();
+      }
+      keys[id].index = size();
+      conn->id = id;
+      conn->generation = keys[id].generation;
+
+      functions.emplace_back(function);
+      slots.emplace_back(std::move(slot), allocator());
+      signals.emplace_back(signal);
+      batchSlots.emplace_back(batchSlot);
+      trackers.emplace_back(tracker);
+      conns.emplace_back(std::move(conn));
+      ids.emplace_back(id);
+    }
+
+    /// Index of the entry of \p conn, or `npos` if it isn't connected.
+    [[nodiscard]] std::size_t find(const ConnectionBase *conn) const noexcept
+    {
+      if (!conn || conn->id >= std::size(keys)) return npos;
+
+      // Connections of other signals can have a matching key, so the entry is compared as well.
+      const auto &key = keys[conn->id];
+      if (key.generation != conn->generation || key.index == npos) return npos;
+      return conns[key.index].get() == conn ? key.index : npos;
+    }
+
+    [[nodiscard]] bool contains(const ConnectionBase *conn) const noexcept
+    {
+      return find(conn) != npos;
+    }
+
+    /// Erases the entries of \p erasedConns that are connected, without moving the other entries
+    /// unless they need to be compacted.
+    void erase(std::span<const ConnectionBase *const> erasedConns) noexcept
+    {
+      for (const auto *conn : erasedConns) {
+        if (const auto index = find(conn); index != npos) {
+          eraseAt(index);
+        }
+      }
+      if (erased * 4 > size()) {
+        compact();
+      }
+    }
+
+    /// Erases the entries at the indices matching \p pred while keeping the order of the remaining
+    /// ones.
+    template <typename Pred>
+    void eraseIf(Pred &&pred) noexcept
+    {
+      for (std::size_t i = 0; i < size(); ++i) {
+        if (conns[i] && pred(*this, i)) {
+          eraseAt(i);
+        }
+      }
+      compact();
+    }
+
+    /// Empties the entry at \p index without erasing it, so that emissions in progress pass over
+    /// it, and moves its slot to \p retired since it may be running.
+    /** Moving a slot leaves a callable stored on the heap in place and the bytes of an inline one
+        behind, so a slot disabling its own entry keeps running unaffected. */
+    void disable(std::size_t index, Vector<Slot> &retired) noexcept
+    {
+      if (signals[index]) {
+        --signalCount;
+      }
+      functions[index] = nullptr;
+      if (auto &slot = slots[index]; slot) {
+        retired.emplace_back(std::move(slot));
+      }
+      signals[index] = nullptr;
+      batchSlots[index] = nullptr;
+      trackers[index] = nullptr;
+    }
+
+    /// Erases the entries of tracked slots whose object is gone if emission came across any since
+    /// the last call.
+    void eraseExpired() noexcept
+    {
+      if (!expiredTrackers.lower()) return;
+
+      for (std::size_t i = 0; i < size(); ++i) {
+        if (const auto *tracker = trackers[i]; tracker && tracker->expired()) {
+          eraseAt(i);
+        }
+      }
+      if (erased * 4 > size()) {
+        compact();
+      }
+    }
+
+    /// Calls \p func unless \p tracker is set and its object is gone, and returns whether it was
+    /// called.
+    /** The object is kept alive during the call. If it is gone, the container is flagged for
+        eraseExpired() instead. */
+    template <typename Func>
+    bool whileAlive(const Tracker *tracker, Func &&func) const
+    {
+      if (!tracker) {
+        func();
+        return true;
+      }
+      if (const auto object = tracker->lock(); object) {
+        func();
+        return true;
+      }
+      expiredTrackers.raise();
+      return false;
+    }
+
+    /// Invokes the plain function, slot, or signal of each entry in connection order, except for
+    /// the entries at indices for which \p skip returns true, until \p stop returns true.
+    /** Consecutive function slots are invoked in a tight loop over the function array, and erased
+        entries are passed over. \p stop is checked after each invoked entry. */
+    template <typename OnFunction, typename OnSlot, typename OnSignal, typename Skip,
+              typename Stop = detail::NeverStop>
+    void forEach(OnFunction &&onFunction, OnSlot &&onSlot, OnSignal &&onSignal, Skip &&skip,
+                 Stop &&stop = Stop()) const
+    {
+      forEach(onFunction, onSlot, onSignal, skip, 0, size(), stop);
+    }
+
+    /// Like above but only for the entries at indices in [\p first, \p count).
+    template <typename OnFunction, typename OnSlot, typename OnSignal, typename Skip,
+              typename Stop = detail::NeverStop>
+    void forEach(OnFunction &&onFunction, OnSlot &&onSlot, OnSignal &&onSignal, Skip &&skip,
+                 std::size_t first, std::size_t count, Stop &&stop = Stop()) const
+    {
+      for (std::size_t i = first; i < count; ++i) {
+        for (; i < count && functions[i]; ++i) {
+          if (!skip(i)) {
+            onFunction(functions[i]);
+            if (stop()) return;
+          }
+        }
+        if (i == count || skip(i)) continue;
+
+        if (const auto &slot = slots[i]; slot) {
+          if (!whileAlive(trackers[i], [&] { onSlot(slot); })) continue;
+        }
+        else if (auto *signal = signals[i]; signal) {
+          onSignal(signal);
+        }
+        else {
+          continue;
+        }
+        if (stop()) return;
+      }
+    }
+
+    /// Plain function slots, which are invoked without type erasure and are null for other entries.
+    Vector<Function> functions;
+
+    /// Slots that aren't plain functions, which are empty for other entries.
+    Vector<Slot> slots;
+
+    /// Connected signals, which are null for other entries.
+    Vector<BasicSignal *> signals;
+
+    /// Slots taking whole batches, which are null for other entries. They are owned by the slot of
+    /// the same entry, which passes single emissions as a batch of one.
+    Vector<const BatchSlot *> batchSlots;
+
+    /// Objects bounding the lifetime of tracked slots, which are null for other entries. They are
+    /// owned by the slot of the same entry.
+    Vector<const Tracker *> trackers;
+
+    /// Connections of the entries, which are null for erased entries.
+    Vector<Connection> conns;
+
+    /// Number of connected signals.
+    std::size_t signalCount = 0;
+
+    /// Raised by emissions that skipped a tracked slot whose object is gone.
+    mutable detail::Flag expiredTrackers;
+
+  private:
+    /// Index of the entry of an id and the generation of the id, which is incremented whenever the
+    /// entry is erased so that stale keys don't match once the id is reused.
+    class Key final {
+    public:
+      std::size_t index = npos;
+      std::uint32_t generation = 0;
+    };
+
+    /// Leaves an empty entry at \p index and frees its id.
+    void eraseAt(std::size_t index) noexcept
+    {
+      if (auto &conn = conns[index]; conn) {
+        conn->storeSignal(nullptr, std::memory_order_release);
+        conn = nullptr;
+      }
+      if (signals[index]) {
+        --signalCount;
+      }
+      functions[index] = nullptr;
+      slots[index] = nullptr;
+      signals[index] = nullptr;
+      batchSlots[index] = nullptr;
+      trackers[index] = nullptr;
+
+      auto &key = keys[ids[index]];
+      key.index = npos;
+      ++key.generation;
+      freeIds.emplace_back(ids[index]);
+      ++erased;
+    }
+
+    /// Removes the empty entries while keeping the order of the remaining ones.
+    void compact() noexcept
+    {
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < size(); ++i) {
+        if (!conns[i]) continue;
+
+        if (kept != i) {
+          functions[kept] = functions[i];
+          slots[kept] = std::move(slots[i]);
+          signals[kept] = signals[i];
+          batchSlots[kept] = batchSlots[i];
+          trackers[kept] = trackers[i];
+          conns[kept] = std::move(conns[i]);
+          ids[kept] = ids[i];
+        }
+        keys[ids[kept]].index = kept;
+        ++kept;
+      }
+
+      const auto end = static_cast<std::ptrdiff_t>(kept);
+      functions.erase(functions.begin() + end, functions.end());
+      slots.erase(slots.begin() + end, slots.end());
+      signals.erase(signals.begin() + end, signals.end());
+      batchSlots.erase(batchSlots.begin() + end, batchSlots.end());
+      trackers.erase(trackers.begin() + end, trackers.end());
+      conns.erase(conns.begin() + end, conns.end());
+      ids.erase(ids.begin() + end, ids.end());
+      erased = 0;
+    }
+
+    /// Id of each entry.
+    Vector<std::size_t> ids;
+
+    /// Key of each id, and the ids that aren't in use.
+    Vector<Key> keys;
+    Vector<std::size_t> freeIds;
+
+    /// Number of empty entries left by erasing.
+    std::size_t erased = 0;
+  };
+
+  class Plan;
+
+  static constexpr bool snapshotEmission = Policy::emission == Emission::Snapshot;
+  static constexpr bool epochEmission = Policy::emission == Emission::Epoch;
+  static constexpr bool lockedEmission = Policy::emission == Emission::Locked;
+  static constexpr bool sharedLocking = detail::SharedLockable<Mutex>;
+  static constexpr bool threadSafe = Policy::threadSafe;
+
+  static_assert(threadSafe || lockedEmission, "Single-threaded signals must use locked emission!");
+
+  /// Entries container shared with ongoing snapshot emissions.
+  class Snapshot final {
+  public:
+    explicit Snapshot(Cont cont_ = {}) noexcept : cont(std::move(cont_))
+    {
+    }
+
+    Cont cont;
+
+    /// Number of emissions currently invoking the slots of `cont`, which is copied on write while
+    /// non-zero.
+    std::atomic_size_t emissions = 0;
+
+    /// Dispatch plan built from `cont` if it has connected signals.
+    std::shared_ptr<const Plan> plan;
+  };
+
+  /// Entries container published to epoch emissions, and the previously published ones which are
+  /// freed once no emission can be using them anymore.
+  /** Retired containers and plans are paired with the epoch returned by EpochDomain::advance()
+      after they were unlocked, see reclaimEntries(). */
+  class Published final {
+  public:
+    Published() noexcept = default;
+
+    /// Containers and plans are allocated with \p allocator_, see makeUnique().
+    explicit Published(const Allocator &allocator_) noexcept
+      : retired(allocator_), retiredPlans(allocator_), allocator(allocator_)
+    {
+    }
+
+    ~Published() noexcept
+    {
+      const Deleter deleter{allocator};
+      if (auto *current = cont.load(); current) {
+        deleter(current);
+      }
+      if (const auto *current = plan.load(); current) {
+        deleter(current);
+      }
+    }
+
+    Published(const Published &) = delete;
+    Published &operator=(const Published &) = delete;
+
+    std::atomic<Cont *> cont = nullptr;
+    Vector<std::pair<UniquePtr<Cont>, std::uint64_t>> retired;
+
+    /// Dispatch plan built from the published container if it has connected signals.
+    std::atomic<const Plan *> plan = nullptr;
+    Vector<std::pair<UniquePtr<const Plan>, std::uint64_t>> retiredPlans;
+
+    [[no_unique_address]] Allocator allocator;
+  };
+
+  /// Emissions of a signal with locked emission, which hold the entries lock while invoking the
+  /// slots.
+  /** Modifications made by an emitting thread, like from within a slot, would deadlock on the
+      entries lock and must not move the entries being iterated either. They are queued instead
+      and applied in order once the outermost emission of the thread exits. With an exclusive lock
+      the entries they disconnect are disabled right away, so the ongoing emission passes over
+      them without checking each entry. With a shared lock other threads may be iterating the
+      entries, so only their connections are marked, and emissions check each entry while any
+      connection is marked.
+
+      With an exclusive lock only the thread holding it can be emitting, so the signal records that
+      thread and counts its nested emissions. With a shared lock several threads can be emitting at
+      once, so each registers the signal in its own list instead. A signal that isn't thread-safe
+      only counts its nested emissions, and guards nothing with its own lock. */
+  class Emitter final {
+  public:
+    /// Deferred modification, which is stored like a slot.
+    using Modification = Delegate<void(Cont &), Policy::slotCapacity, Allocator>;
+
+    Emitter() noexcept = default;
+
+    explicit Emitter(const Allocator &allocator) noexcept
+      : pending(allocator), added(allocator), retired(allocator)
+    {
+    }
+
+    /// Whether the calling thread is emitting the signal.
+    [[nodiscard]] bool current() const noexcept
+    {
+      if constexpr (sharedLocking) {
+        const auto &emitting = detail::emittingSignals();
+        return std::find(emitting.begin(), emitting.end(), this) != emitting.end();
+      }
+      else if constexpr (threadSafe) {
+        // Only the calling thread itself stores its id, so it's never seen by mistake.
+        return owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+      }
+      else {
+        return depth > 0;
+      }
+    }
+
+    /// Expects the entries lock to be held by the calling thread.
+    void enter() noexcept
+    {
+      if constexpr (sharedLocking) {
+        detail::emittingSignals().push_back(this);
+      }
+      else if (depth++ == 0) {
+        if constexpr (threadSafe) {
+          owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        }
+      }
+    }
+
+    /// Returns whether the outermost emission of the calling thread exited.
+    bool exit() noexcept
+    {
+      if constexpr (sharedLocking) {
+        // Emissions of a thread are nested, so the innermost one is this.
+        detail::emittingSignals().pop_back();
+        return !current();
+      }
+      else {
+        if (--depth > 0) return false;
+
+        if constexpr (threadSafe) {
+          owner.store(std::thread::id(), std::memory_order_relaxed);
+        }
+        return true;
+      }
+    }
+
+    /// Queues \p modify, which adds the entry of \p conn if given.
+    template <typename Func>
+    void defer(Func &&modify, Connection conn = nullptr) noexcept
+    {
+      std::scoped_lock lock(mutex);
+      if (conn) {
+        added.push_back(std::move(conn));
+      }
+      pending.emplace_back(std::forward<Func>(modify), Allocator(pending.get_allocator()));
+      deferred.store(true, std::memory_order_relaxed);
+    }
+
+    /// Connection added by a pending modification, or null.
+    [[nodiscard]] Connection findAdded(const ConnectionBase *conn) noexcept
+    {
+      std::scoped_lock lock(mutex);
+      const auto it = std::find_if(added.begin(), added.end(),
+                                   [conn](const auto &other) { return other.get() == conn; });
+      return it != added.end() ? *it : nullptr;
+    }
+
+    /// Guards the pending modifications, which emitting threads can queue concurrently with a
+    /// shared lock.
+    [[no_unique_address]] std::conditional_t<threadSafe, std::mutex, Mutex> mutex;
+
+    /// Modifications deferred until the outermost emission exits.
+    Vector<Modification> pending;
+
+    /// Connections of the entries added by pending modifications.
+    Vector<Connection> added;
+
+    /// Whether there are pending modifications.
+    detail::Atomic<bool, threadSafe> deferred = false;
+
+    /// Whether any connection of the entries is marked, with a shared lock.
+    detail::Atomic<bool, threadSafe> marked = false;
+
+    /// Slots of disabled entries, which may still be running, with an exclusive lock.
+    Vector<Slot> retired;
+
+    /// Whether emitParallel() is running, whose tasks read the entries concurrently, so entries
+    /// aren't disabled meanwhile, with an exclusive lock.
+    bool parallel = false;
+
+    /// Thread emitting the signal with an exclusive lock.
+    detail::Atomic<std::thread::id, threadSafe> owner;
+
+    /// Number of nested emissions, unless locked shared.
+    std::size_t depth = 0;
+  };
+
+  /// Queued connection, see connect(EventLoop &, Slot).
+  class Queue final {
+  public:
+    class Event final : public EventLoop::Event {
+    public:
+      Event() noexcept : EventLoop::Event(&Queue::deliver)
+      {
+      }
+
+      std::atomic_uint32_t nextFree = 0;
+      std::optional<std::tuple<std::decay_t<Args>...>> values;
+
+      /// Keeps the queue, and thereby the pool owning this event, alive while queued.
+      std::shared_ptr<Queue> queue;
+    };
+
+    /// The slot, the pool, and the events allocated beyond it use \p allocator_.
+    Queue(EventLoop &loop_, Slot &&slot_, std::size_t poolSize,
+          const Allocator &allocator_) noexcept
+      : loop(loop_), slot(std::move(slot_), allocator_), pool(poolSize, allocator_),
+        allocator(allocator_)
+    {
+    }
+
+    template <typename... Values>
+    static void post(const std::shared_ptr<Queue> &queue, Values &&...values) noexcept
+    {
+      auto *event = queue->pool.acquire();
+      if (!event) {
+        event = makeUnique<Event>(queue->allocator).release();
+      }
+      event->values.emplace(std::forward<Values>(values)...);
+      event->queue = queue;
+      queue->loop.post(*event);
+    }
+
+  private:
+    static void deliver(EventLoop::Event &base, bool run) noexcept
+    {
+      auto &event = static_cast<Event &>(base);
+      if (run) {
+        std::apply(
+          [&event](auto &...values) { event.queue->slot(static_cast<Args &&>(values)...); },
+          *event.values);
+      }
+      event.values.reset();
+
+      // Released before the queue, which might be the last reference to the pool.
+      auto queue = std::move(event.queue);
+      if (queue->pool.owns(&event)) {
+        queue->pool.release(&event);
+      }
+      else {
+        Deleter{queue->allocator}(&event);
+      }
+    }
+
+    EventLoop &loop;
+    Slot slot;
+    detail::NodePool<Event, Allocator> pool;
+    [[no_unique_address]] Allocator allocator;
+  };
+
+  using Values = std::tuple<std::decay_t<Args>...>;
+
+  /// Whether coroutines can await emissions, which requires copying the arguments.
+  static constexpr bool awaitable = std::is_constructible_v<Values, const std::decay_t<Args> &...>;
+
+  class WaiterList;
+
+  /// Coroutine waiting for the next emission, see next().
+  /** The waiter is in the list of its signal until an emission takes it, and then in the list of
+      that emission until it's resumed. If the coroutine is destroyed while suspended, the waiter
+      removes itself from whichever list it's in, so it's never resumed. */
+  class Waiter {
+  public:
+    /// Resumes the coroutine of the waiter.
+    using Resume = void (*)(Waiter &);
+
+    explicit Waiter(Resume resume_) noexcept : resume(resume_)
+    {
+    }
+
+    ~Waiter() noexcept
+    {
+      // The list can change while unlocked, since an emission can take the waiter meanwhile.
+      for (;;) {
+        auto *current = list.load(std::memory_order_acquire);
+        if (!current) return;
+
+        std::scoped_lock lock(current->mutex);
+        if (list.load(std::memory_order_relaxed) == current) {
+          current->remove(*this);
+          return;
+        }
+      }
+    }
+
+    Waiter(const Waiter &) = delete;
+    Waiter &operator=(const Waiter &) = delete;
+
+    std::coroutine_handle<> handle;
+    std::optional<Values> values;
+    Resume resume = nullptr;
+
+    /// List the waiter is in, or null if it's not waiting.
+    detail::Atomic<WaiterList *, threadSafe> list = nullptr;
+    Waiter *prevWaiter = nullptr, *nextWaiter = nullptr;
+  };
+
+  /// Waiters of a signal or of an emission in the order they started waiting.
+  class WaiterList final {
+  public:
+    WaiterList() noexcept = default;
+
+    WaiterList(const WaiterList &) = delete;
+    WaiterList &operator=(const WaiterList &) = delete;
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+      return !head.load(std::memory_order_relaxed);
+    }
+
+    void push(Waiter &waiter) noexcept
+    {
+      std::scoped_lock lock(mutex);
+      link(waiter);
+    }
+
+    /// Moves all waiters to the end of \p other.
+    void moveTo(WaiterList &other) noexcept
+    {
+      if (empty()) return;
+
+      std::scoped_lock lock(mutex, other.mutex);
+      while (auto *waiter = head.load(std::memory_order_relaxed)) {
+        remove(*waiter);
+        other.link(*waiter);
+      }
+    }
+
+    /// Removes the first waiter and returns it, or null if there is none.
+    [[nodiscard]] Waiter *pop() noexcept
+    {
+      if (empty()) return nullptr;
+
+      std::scoped_lock lock(mutex);
+      auto *waiter = head.load(std::memory_order_relaxed);
+      if (waiter) {
+        remove(*waiter);
+      }
+      return waiter;
+    }
+
+    /// Expects the list to be locked beforehand.
+    void remove(Waiter &waiter) noexcept
+    {
+      if (waiter.prevWaiter) {
+        waiter.prevWaiter->nextWaiter = waiter.nextWaiter;
+      }
+      else {
+        head.store(waiter.nextWaiter, std::memory_order_relaxed);
+      }
+      if (waiter.nextWaiter) {
+        waiter.nextWaiter->prevWaiter = waiter.prevWaiter;
+      }
+      else {
+        tail = waiter.prevWaiter;
+      }
+      waiter.prevWaiter = waiter.nextWaiter = nullptr;
+      waiter.list.store(nullptr, std::memory_order_release);
+    }
+
+    [[no_unique_address]] std::conditional_t<threadSafe, std::mutex, Mutex> mutex;
+
+  private:
+    /// Expects the list to be locked beforehand.
+    void link(Waiter &waiter) noexcept
+    {
+      waiter.prevWaiter = tail;
+      if (tail) {
+        tail->nextWaiter = &waiter;
+      }
+      else {
+        head.store(&waiter, std::memory_order_relaxed);
+      }
+      tail = &waiter;
+      waiter.list.store(this, std::memory_order_release);
+    }
+
+    /// Read without the lock to skip empty lists cheaply.
+    detail::Atomic<Waiter *, threadSafe> head = nullptr;
+    Waiter *tail = nullptr;
+  };
+
+  /// Resumes coroutines on the emitting thread.
+  class Inline final {};
+
+  /// Awaitable returned by next().
+  template <typename Exec>
+  class Next final : private Waiter {
+  public:
+    Next(BasicSignal *signal_, Exec *executor_) noexcept
+      : Waiter(&Next::resumeWaiter), signal(signal_), executor(executor_)
+    {
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept
+    {
+      return false;
+    }
+
+    /// The coroutine may be resumed by another thread as soon as the waiter has been added, so
+    /// nothing is accessed afterwards.
+    void await_suspend(std::coroutine_handle<> handle_) noexcept
+    {
+      this->handle = handle_;
+      signal->waiters.push(*this);
+    }
+
+    /// No value if the signal was destroyed.
+    [[nodiscard]] std::optional<Values> await_resume() noexcept
+    {
+      return std::move(this->values);
+    }
+
+  private:
+    static void resumeWaiter(Waiter &waiter) noexcept
+    {
+      auto &next = static_cast<Next &>(waiter);
+      if constexpr (std::is_same_v<Exec, Inline>) {
+        next.handle.resume();
+      }
+      else {
+        next.executor->execute([handle = next.handle] { handle.resume(); });
+      }
+    }
+
+    BasicSignal *signal = nullptr;
+    Exec *executor = nullptr;
+  };
+
+  /// Moves all waiters to \p list, which are resumed once the emission is done.
+  void takeWaiters(WaiterList &list) const noexcept
+  {
+    waiters.moveTo(list);
+  }
+
+  /// Resumes the waiters of \p list with copies of \p args, or without values if there are none.
+  /** The coroutine of a waiter can be destroyed until it's taken from the list, and the waiter is
+      gone once resumed. */
+  static void resumeWaiters(WaiterList &list,
+                            [[maybe_unused]] const std::decay_t<Args> &...args) noexcept
+  {
+    if constexpr (awaitable) {
+      while (auto *waiter = list.pop()) {
+        waiter->values.emplace(args...);
+        waiter->resume(*waiter);
+      }
+    }
+  }
+
+  /// Resumes the waiters of \p list without values, since the signal is destroyed.
+  static void closeWaiters(WaiterList &list) noexcept
+  {
+    while (auto *waiter = list.pop()) {
+      waiter->resume(*waiter);
+    }
+  }
+
+public:
+  /// Buffered stream of emissions, see stream().
+  class Stream final {
+    /// Waits in the stream list of the signal to be closed once the signal is destroyed.
+    class State final : public Waiter {
+    public:
+      explicit State(std::function<void(std::coroutine_handle<>)> resume_) noexcept
+        : Waiter(&State::close), resume(std::move(resume_))
+      {
+      }
+
+      /// Takes the oldest buffered emission into \p next, if any, and returns whether the read is
+      /// done, which it also is once closed. Expects the state to be locked.
+      bool take(std::optional<Values> &next) noexcept
+      {
+        if (buffer.empty()) return closed;
+
+        next.emplace(std::move(buffer.front()));
+        buffer.pop_front();
+        return true;
+      }
+
+      std::mutex mutex;
+      std::deque<Values> buffer;
+
+      /// Reading coroutine waiting for the next emission and where to put its arguments.
+      std::coroutine_handle<> waiting;
+      std::optional<Values> *target = nullptr;
+
+      /// Set once the signal is destroyed, after which reads only drain the buffer.
+      bool closed = false;
+
+      std::function<void(std::coroutine_handle<>)> resume;
+
+    private:
+      /// Resumes the reading coroutine, if any, without values.
+      static void close(Waiter &waiter) noexcept
+      {
+        auto &state = static_cast<State &>(waiter);
+        std::coroutine_handle<> waiting;
+        {
+          std::scoped_lock lock(state.mutex);
+          state.closed = true;
+          state.target = nullptr;
+          waiting = std::exchange(state.waiting, nullptr);
+        }
+        if (waiting) {
+          state.resume(waiting);
+        }
+      }
+    };
+
+  public:
+    /// Awaitable returned by next().
+    class Next final {
+    public:
+      explicit Next(std::shared_ptr<State> state_) noexcept : state(std::move(state_))
+      {
+      }
+
+      /// Stops waiting if the reading coroutine is destroyed while suspended.
+      ~Next() noexcept
+      {
+        std::scoped_lock lock(state->mutex);
+        if (state->target == &values) {
+          state->waiting = nullptr;
+          state->target = nullptr;
+        }
+      }
+
+      /// Takes the oldest buffered emission, if any, without suspending.
+      [[nodiscard]] bool await_ready() noexcept
+      {
+        std::scoped_lock lock(state->mutex);
+        return state->take(values);
+      }
+
+      /// Suspends unless an emission was buffered or the signal destroyed meanwhile.
+      bool await_suspend(std::coroutine_handle<> handle) noexcept
+      {
+        std::scoped_lock lock(state->mutex);
+        if (state->take(values)) return false;
+
+        assert(!state->waiting && "Only one coroutine can read a stream at a time.");
+        state->waiting = handle;
+        state->target = &values;
+        return true;
+      }
+
+      /// No value if the signal was destroyed and all buffered emissions have been read.
+      [[nodiscard]] std::optional<Values> await_resume() noexcept
+      {
+        return std::move(values);
+      }
+
+    private:
+      std::shared_ptr<State> state;
+      std::optional<Values> values;
+    };
+
+    Stream(BasicSignal &signal, std::function<void(std::coroutine_handle<>)> resume) noexcept
+      : state(std::make_shared<State>(std::move(resume)))
+    {
+      signal.streams.push(*state);
+      conn = signal.connect([state = state](const auto &...args) {
+        std::coroutine_handle<> waiting;
+        {
+          std::scoped_lock lock(state->mutex);
+          if (!state->waiting) {
+            state->buffer.emplace_back(args...);
+            return;
+          }
+          state->target->emplace(args...);
+          waiting = std::exchange(state->waiting, nullptr);
+        }
+        state->resume(waiting);
+      });
+    }
+
+    /// Disconnects from the signal, if it still exists.
+    ~Stream() noexcept
+    {
+      if (conn) {
+        conn->disconnect();
+      }
+    }
+
+    Stream(Stream &&rhs) noexcept = default;
+
+    /// Disconnects this stream from its signal before taking over \p rhs.
+    Stream &operator=(Stream &&rhs) noexcept
+    {
+      if (this != &rhs) {
+        if (conn) {
+          conn->disconnect();
+        }
+        state = std::move(rhs.state);
+        conn = std::move(rhs.conn);
+      }
+      return *this;
+    }
+
+    [[nodiscard]] Next next() noexcept
+    {
+      return Next(state);
+    }
+
+    /// Number of emissions buffered but not read yet.
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+      std::scoped_lock lock(state->mutex);
+      return std::size(state->buffer);
+    }
+
+  private:
+    std::shared_ptr<State> state;
+    Connection conn;
+  };
+
+private:
+  /// Flattened dispatch plan of the entries of a signal and of all signals reachable through it.
+  /** Connected signals are expanded in place, so an emission invokes all reachable slots in one
+      loop instead of recursing into each signal. The plan records the version of each member signal
+      it was built from and must be rebuilt once any of them has been modified. It points into the
+      containers of the members, which is only safe with snapshot and epoch emission where those are
+      immutable while in use. */
+  class Plan final {
+  public:
+    class Member final {
+    public:
+      const BasicSignal *signal = nullptr;
+      std::uint64_t version = 0;
+      const Cont *cont = nullptr;
+
+      /// Keeps `cont` alive with snapshot emission, and copied on write while the plan is entered.
+      std::shared_ptr<Snapshot> snapshot;
+    };
+
+    Plan() noexcept = default;
+
+    /// The arrays allocate with \p allocator.
+    explicit Plan(const Allocator &allocator) noexcept
+      : functions(allocator), slots(allocator), trackers(allocator), signals(allocator),
+        ends(allocator), owners(allocator), indices(allocator), members(allocator)
+    {
+    }
+
+    Plan(const Plan &) = delete;
+    Plan &operator=(const Plan &) = delete;
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+      return std::size(functions);
+    }
+
+    /// Whether none of the members has been modified since the plan was built.
+    /** Members are checked in the order they were reached, so a signal that was disconnected, and
+        possibly destroyed, is never accessed since the signal it was disconnected from comes
+        first. */
+    [[nodiscard]] bool current() const noexcept
+    {
+      for (const auto &member : members) {
+        if (member.signal->entriesVersion.load() != member.version) return false;
+      }
+      return true;
+    }
+
+    /// Counts an emission of the member snapshots, so they are copied on write until leave(), if
+    /// none of the members has been modified since the plan was built, and returns whether it did.
+    /** Each member is checked while holding its entries lock, like a snapshot emission of it would,
+        and in the order of current(). A plan is built entered, see expandPlan(), and only cached
+        plans are entered again, so modifying a member in place stays possible between emissions.
+        */
+    [[nodiscard]] bool enter() const noexcept
+    {
+      for (std::size_t i = 0; i < std::size(members); ++i) {
+        const auto &member = members[i];
+        ReadLock lock(member.signal->entriesMutex);
+        if (member.signal->entriesVersion.load() != member.version ||
+            (member.snapshot && member.signal->entries != member.snapshot)) {
+          leave(i);
+          return false;
+        }
+        if (member.snapshot) {
+          member.snapshot->emissions.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      return true;
+    }
+
+    /// Ends the emission of the first \p count member snapshots, see enter().
+    void leave(std::size_t count) const noexcept
+    {
+      for (std::size_t i = 0; i < count; ++i) {
+        if (const auto &snapshot = members[i].snapshot; snapshot) {
+          snapshot->emissions.fetch_sub(1, std::memory_order_release);
+        }
+      }
+    }
+
+    void leave() const noexcept
+    {
+      leave(std::size(members));
+    }
+
+    void add(Function function, const Slot *slot, const Tracker *tracker,
+             const BasicSignal *signal, std::size_t owner, std::size_t index) noexcept
+    {
+      functions.emplace_back(function);
+      slots.emplace_back(slot);
+      trackers.emplace_back(tracker);
+      signals.emplace_back(signal);
+      ends.emplace_back(size());
+      owners.emplace_back(owner);
+      indices.emplace_back(index);
+    }
+
+    /// Invokes the plain function or slot of each entry in order, except for the entries at indices
+    /// for which \p skip returns true, and calls \p onEnter with each connected signal reached.
+    /** Reaching a connected signal that is blocked, or skipped, skips all entries expanded from it.
+        Consecutive function slots are invoked in a tight loop over the function array. Once \p stop
+        returns true after invoking an entry, the remaining entries of all signals are skipped. */
+    template <typename OnFunction, typename OnSlot, typename OnEnter, typename Skip,
+              typename Stop = detail::NeverStop>
+    void forEach(OnFunction &&onFunction, OnSlot &&onSlot, OnEnter &&onEnter, Skip &&skip,
+                 Stop &&stop = Stop()) const
+    {
+      const auto count = size();
+      for (std::size_t i = 0; i < count;) {
+        for (; i < count && functions[i]; ++i) {
+          if (!skip(i)) {
+            onFunction(functions[i]);
+            if (stop()) return;
+          }
+        }
+        if (i == count) break;
+
+        if (skip(i)) {
+          i = ends[i];
+        }
+        else if (const auto *slot = slots[i]; slot) {
+          const auto *owner = members[owners[i]].cont;
+          if (owner->whileAlive(trackers[i], [&] { onSlot(*slot); }) && stop()) return;
+          ++i;
+        }
+        else if (signals[i]->blocked()) {
+          i = ends[i];
+        }
+        else {
+          onEnter(*signals[i]);
+          ++i;
+        }
+      }
+    }
+
+    /// Plain function slots, which are null for other entries.
+    Vector<Function> functions;
+
+    /// Slots that aren't plain functions, which are null for other entries.
+    Vector<const Slot *> slots;
+
+    /// Objects bounding the lifetime of tracked slots, which are null for other entries.
+    Vector<const Tracker *> trackers;
+
+    /// Connected signals, whose entries follow them in the plan, which are null for other entries.
+    Vector<const BasicSignal *> signals;
+
+    /// Index following an entry, and all entries expanded from it.
+    Vector<std::size_t> ends;
+
+    /// Index of the member owning each entry and the index of the entry in its container.
+    Vector<std::size_t> owners, indices;
+
+    Vector<Member> members;
+  };
+
+  using Entries =
+    std::conditional_t<snapshotEmission, std::shared_ptr<Snapshot>,
+                       std::conditional_t<epochEmission, Published, Cont>>;
+
+public:
+  using SlotType = Slot;
+
+  /// Interface that only exposes connect and disconnect methods.
+  class Interface final {
+  public:
+    explicit constexpr Interface(SignalType *sig) noexcept : sig_(sig)
+    {
+    }
+
+    constexpr ~Interface() noexcept = default;
+
+    constexpr Interface(const Interface &) = delete;
+    constexpr Interface(Interface &&) = delete;
+
+    constexpr Interface &operator=(const Interface &) = delete;
+    constexpr Interface &operator=(Interface &&) = delete;
+
+    template <typename Func>
+      requires std::is_convertible_v<Func, Function>
+    Connection connect(Func &&func) noexcept
+    {
+      return sig_->connect(std::forward<Func>(func));
+    }
+
+    template <typename Func, typename Fn = std::decay_t<Func>>
+      requires(!std::is_convertible_v<Func, Function> && !std::is_same_v<Fn, Slot> &&
+               !std::is_base_of_v<BasicSignal, Fn> && std::is_invocable_r_v<Ret, Fn &, Args...>)
+    Connection connect(Func &&func) noexcept
+    {
+      return sig_->connect(std::forward<Func>(func));
+    }
+
+    Connection connect(const Slot &slot) noexcept
+    {
+      return sig_->connect(slot);
+    }
+
+    Connection connect(Slot &&slot) noexcept
+    {
+      return sig_->connect(std::move(slot));
+    }
+
+    template <std::ranges::input_range Range,
+              typename Elem = std::remove_reference_t<std::ranges::range_reference_t<Range>>>
+      requires(!std::is_base_of_v<BasicSignal, std::remove_cv_t<Elem>> &&
+               std::is_invocable_r_v<Ret, Elem &, Args...>)
+    std::vector<Connection> connectAll(Range &&funcs) noexcept
+    {
+      return sig_->connectAll(std::forward<Range>(funcs));
+    }
+
+    template <typename Instance, typename MembFunc>
+    Connection connect(Instance *instance, MembFunc Instance::*mf) noexcept
+    {
+      return sig_->connect(instance, mf);
+    }
+
+    template <auto MembFunc, typename Instance>
+    Connection connect(Instance *instance) noexcept
+    {
+      return sig_->template connect<MembFunc>(instance);
+    }
+
+    template <typename T, typename Func>
+      requires std::is_invocable_r_v<Ret, std::decay_t<Func> &, Args...>
+    Connection connect(std::weak_ptr<T> tracker, Func &&func) noexcept
+    {
+      return sig_->connect(std::move(tracker), std::forward<Func>(func));
+    }
+
+    template <typename Instance, typename MembFunc>
+    Connection connect(std::weak_ptr<Instance> instance, MembFunc Instance::*mf) noexcept
+    {
+      return sig_->connect(std::move(instance), mf);
+    }
+
+    Connection connect(BasicSignal &signal) noexcept
+    {
+      return sig_->connect(signal);
+    }
+
+    Connection connect(EventLoop &loop, Slot slot, std::size_t poolSize = 64) noexcept
+      requires std::is_void_v<Ret>
+    {
+      return sig_->connect(loop, std::move(slot), poolSize);
+    }
+
+    Connection connectBatch(BatchSlot slot) noexcept
+      requires std::is_void_v<Ret>
+    {
+      return sig_->connectBatch(std::move(slot));
+    }
+
+    void disconnect(std::optional<Connection> conn) noexcept
+    {
+      sig_->disconnect(conn);
+    }
+
+    constexpr void disconnect(BasicSignal &signal) noexcept
+    {
+      sig_->disconnect(signal);
+    }
+
+  private:
+    SignalType *sig_ = nullptr;
+  };
+
+  constexpr BasicSignal() noexcept = default;
+
+  /// Constructs a signal whose entries, connections, slots stored on the heap, and the structures
+  /// emissions and modifications keep besides them are allocated with \p allocator_.
+  /** Example:
+        std::pmr::monotonic_buffer_resource arena;
+        sigs::PmrSignal<void()> s(&arena);
+      */
+  constexpr explicit BasicSignal(const Allocator &allocator_) noexcept
+    : allocator(allocator_), entries(makeEntries(allocator_)), emitter(allocator_),
+      connectedSignals(allocator_)
+  {
+  }
+
+  /// Resumes the coroutines awaiting next(), or reading a stream, without values.
+  /** With epoch emission, waits for the emissions of other threads that may still be using the
+      entries, like through a signal this one was connected to, before freeing them. */
+  constexpr virtual ~BasicSignal() noexcept
+  {
+    {
+      Lock lock(entriesMutex);
+      for (const auto &conn : currentEntries().conns) {
+        if (conn) {
+          conn->storeSignal(nullptr, std::memory_order_release);
+        }
+      }
+    }
+    closeWaiters(waiters);
+    closeWaiters(streams);
+
+    if constexpr (epochEmission) {
+      if (entries.cont.load(std::memory_order_relaxed)) {
+        detail::EpochDomain::instance().synchronize();
+      }
+    }
+  }
+
+  constexpr BasicSignal(const BasicSignal &rhs) noexcept
+    : BasicSignal(std::allocator_traits<Allocator>::select_on_container_copy_construction(
+        rhs.allocator))
+  {
+    Lock lock1(entriesMutex);
+    ReadLock lock2(rhs.entriesMutex);
+    copyEntries(rhs);
+    copyConnectedSignals(rhs);
+
+    // `atomic_bool` can't be copied, so copy value.
+    blocked_ = rhs.blocked_.load();
+  }
+
+  constexpr BasicSignal &operator=(const BasicSignal &rhs) noexcept
+  {
+    {
+      Lock lock1(entriesMutex);
+      ReadLock lock2(rhs.entriesMutex);
+      applyExitedDeferred();
+      copyEntries(rhs);
+      copyConnectedSignals(rhs);
+      blocked_ = rhs.blocked_.load();
+    }
+    waitForEmissions();
+    reclaimEntries();
+    return *this;
+  }
+
+  constexpr BasicSignal(BasicSignal &&rhs) noexcept = default;
+  constexpr BasicSignal &operator=(BasicSignal &&rhs) noexcept = default;
+
+  constexpr std::size_t size() const noexcept
+  {
+    if constexpr (lockedEmission) {
+      if (emitter.current()) return entries.connectedCount();
+    }
+
+    ReadLock lock(entriesMutex);
+    return currentEntries().connectedCount();
+  }
+
+  constexpr bool empty() const noexcept
+  {
+    return 0 == size();
+  }
+
+  /// Connects a plain function, or a captureless lambda, with the exact signature of the signal.
+  /** It is invoked directly without any type erasure. */
+  template <typename Func>
+    requires std::is_convertible_v<Func, Function>
+  Connection connect(Func &&func) noexcept
+  {
+    auto conn = makeConnection();
+    addEntry(conn, static_cast<Function>(func));
+    return conn;
+  }
+
+  /// Connects callable \p func, which is stored in a slot allocating with the allocator of the
+  /// signal, so it's never allocated with the default allocator first.
+  template <typename Func, typename Fn = std::decay_t<Func>>
+    requires(!std::is_convertible_v<Func, Function> && !std::is_same_v<Fn, Slot> &&
+             !std::is_base_of_v<BasicSignal, Fn> && std::is_invocable_r_v<Ret, Fn &, Args...>)
+  Connection connect(Func &&func) noexcept
+  {
+    auto conn = makeConnection();
+    addEntry(conn, nullptr, Slot(std::forward<Func>(func), allocator));
+    return conn;
+  }
+
+  Connection connect(const Slot &slot) noexcept
+  {
+    auto conn = makeConnection();
+    addEntry(conn, nullptr, Slot(slot));
+    return conn;
+  }
+
+  Connection connect(Slot &&slot) noexcept
+  {
+    auto conn = makeConnection();
+    addEntry(conn, nullptr, std::move(slot));
+    return conn;
+  }
+
+  /// Connects each plain function, callable, or slot of \p funcs like connect() above, and returns
+  /// their connections in the same order.
+  /** The entries are modified only once for all of them. With snapshot and epoch emission each
+      modification copies all entries, so connecting n slots one at a time copies O(n²) entries in
+      total, while this copies them once.
+
+      Example:
+        std::vector<std::function<void(int)>> funcs = ...;
+        auto conns = signal.connectAll(funcs);
+      */
+  template <std::ranges::input_range Range,
+            typename Elem = std::remove_reference_t<std::ranges::range_reference_t<Range>>>
+    requires(!std::is_base_of_v<BasicSignal, std::remove_cv_t<Elem>> &&
+             std::is_invocable_r_v<Ret, Elem &, Args...>)
+  std::vector<Connection> connectAll(Range &&funcs) noexcept
+  {
+    std::vector<Connection> conns;
+    Vector<Function> functions(allocator);
+    Vector<Slot> slots(allocator);
+    for (auto &&func : funcs) {
+      conns.push_back(makeConnection());
+      if constexpr (std::is_convertible_v<Elem &, Function>) {
+        functions.emplace_back(func);
+        slots.emplace_back();
+      }
+      else {
+        functions.emplace_back(nullptr);
+        slots.emplace_back(std::forward<decltype(func)>(func), allocator);
+      }
+    }
+
+    if constexpr (lockedEmission) {
+      if (emitter.current()) {
+        for (std::size_t i = 0; i < std::size(conns); ++i) {
+          addEntry(conns[i], functions[i], std::move(slots[i]));
+        }
+        return conns;
+      }
+    }
+
+    {
+      Lock lock(entriesMutex);
+      applyExitedDeferred();
+      modifyEntries([&](Cont &cont) {
+        cont.reserve(cont.size() + std::size(conns));
+        for (std::size_t i = 0; i < std::size(conns); ++i) {
+          cont.add(conns[i], functions[i], std::move(slots[i]), nullptr, nullptr, nullptr);
+        }
+      });
+    }
+    reclaimEntries();
+    return conns;
+  }
+
+  template <typename Instance, typename MembFunc>
+  Connection connect(Instance *instance, MembFunc Instance::*mf) noexcept
+  {
+    auto conn = makeConnection();
+    addEntry(conn, nullptr, Slot::bind(instance, mf));
+    return conn;
+  }
+
+  /// Connects member function `MembFunc` of \p instance, which is called directly by the slot.
+  /** Example:
+      signal.connect<&TheClass::func>(&instance);
+      */
+  template <auto MembFunc, typename Instance>
+  Connection connect(Instance *instance) noexcept
+  {
+    auto conn = makeConnection();
+    addEntry(conn, nullptr, Slot::template bind<MembFunc>(instance));
+    return conn;
+  }
+
+  /// Connects \p slot to be invoked only while the object of \p tracker is alive.
+  /** Emission locks \p tracker once for each invocation of the slot, which keeps the object alive
+      during the call, and skips the slot once the object is gone. Such entries are left in place
+      and counted by size() until the next time the signal is modified, which erases them and
+      disconnects their connections.
+
+      Example:
+        signal.connect(std::weak_ptr(widget), [raw = widget.get()] { raw->update(); });
+      */
+  template <typename T, typename Func>
+    requires std::is_invocable_r_v<Ret, std::decay_t<Func> &, Args...>
+  Connection connect(std::weak_ptr<T> tracker, Func &&func) noexcept
+  {
+    std::shared_ptr<const Tracker> trackerPtr =
+      std::allocate_shared<Tracker>(allocator, std::move(tracker));
+    const auto *tracked = trackerPtr.get();
+    auto conn = makeConnection();
+    addEntry(conn, nullptr,
+             Slot(
+               [trackerPtr = std::move(trackerPtr),
+                slot = Slot(std::forward<Func>(func), allocator)](auto &&...args) {
+                 return slot(std::forward<decltype(args)>(args)...);
+               },
+               allocator),
+             nullptr, nullptr, tracked);
+    return conn;
+  }
+
+  /// Connects member function \p mf of the object of \p instance while it is alive, see above.
+  template <typename Instance, typename MembFunc>
+  Connection connect(std::weak_ptr<Instance> instance, MembFunc Instance::*mf) noexcept
+  {
+    auto *object = instance.lock().get();
+    return connect(std::move(instance), Slot::bind(object, mf));
+  }
+
+  /// Connecting a signal will trigger all of its slots when this signal is triggered.
+  /** Connected signals must not form a cycle, so if this signal can be reached from \p signal,
+      nothing is connected and an empty connection is returned. Connecting to self also fails a
+      debug assertion. Copying a signal copies its connections to other signals without this
+      check. */
+  Connection connect(BasicSignal &signal) noexcept
+  {
+    assert(&signal != this && "Connecting to self would emit recursively.");
+
+    auto conn = makeConnection();
+    if (!connectAcyclic(signal, conn)) return {};
+
+    addEntry(conn, nullptr, {}, &signal);
+    return conn;
+  }
+
+  /// Connects \p slot to be invoked by \p loop when it is drained, instead of by the emitting
+  /// thread.
+  /** Each emission copies, or moves, the arguments into an event queued on \p loop. The events
+      come from a pool of \p poolSize nodes allocated up front, and further events are only
+      allocated while all of them are queued. Like with Qt's queued connections, events already
+      queued are still delivered after disconnecting, and \p loop must outlive the connection. */
+  Connection connect(EventLoop &loop, Slot slot, std::size_t poolSize = 64) noexcept
+    requires std::is_void_v<Ret>
+  {
+    auto queue = std::allocate_shared<Queue>(allocator, loop, std::move(slot), poolSize, allocator);
+    return connect(Slot(
+      [queue = std::move(queue)](auto &&...args) {
+        Queue::post(queue, std::forward<decltype(args)>(args)...);
+      },
+      allocator));
+  }
+
+  /// Connects \p slot to receive the events passed to emitBatch() in one call.
+  /** Regular emissions pass it a batch of one event. */
+  Connection connectBatch(BatchSlot slot) noexcept
+    requires std::is_void_v<Ret>
+  {
+    auto batchSlot = std::allocate_shared<BatchSlot>(allocator, std::move(slot), allocator);
+    const auto *batchSlotPtr = batchSlot.get();
+    auto conn = makeConnection();
+    addEntry(conn, nullptr,
+             Slot(
+               [batchSlot = std::move(batchSlot)](auto &&...args) {
+                 const std::tuple<Args...> event(std::forward<decltype(args)>(args)...);
+                 (*batchSlot)(Batch(&event, 1));
+               },
+               allocator),
+             nullptr, batchSlotPtr);
+    return conn;
+  }
+
+  constexpr void clear() noexcept
+  {
+    eraseEntries([](const Cont & /*unused*/, std::size_t /*unused*/) { return true; });
   }
 
   /// Disconnects \p conn from signal.
   /** If no value is given, all slots are disconnected. */
   constexpr void disconnect(const std::optional<Connection> &conn = std::nullopt) noexcept
   {
-    if (!conn) {
-      clear();
-      return;
+    if (!conn) {
+      clear();
+      return;
+    }
+
+    const ConnectionBase *base = conn->get();
+    disconnectEntries({&base, 1});
+  }
+
+  constexpr void disconnect(BasicSignal &signal) noexcept
+  {
+    assert(&signal != this && "Disconnecting from self has no effect.");
+
+    eraseEntries(
+      [sig = &signal](const Cont &cont, std::size_t i) { return cont.signals[i] == sig; });
+  }
+
+  constexpr void operator()(Args &&...args) noexcept
+  {
+    if (blocked()) return;
+
+    WaiterList waiting;
+    takeWaiters(waiting);
+    forEachEntry([&](Function function) { function(std::forward<const Args>(args)...); },
+                 [&](const Slot &slot) { slot(std::forward<const Args>(args)...); },
+                 [&](BasicSignal *sig) { (*sig)(std::forward<Args>(args)...); },
+                 [&](const BasicSignal &sig) { sig.takeWaiters(waiting); });
+    resumeWaiters(waiting, args...);
+  }
+
+  template <typename RetFunc = typename detail::VoidableFunction<ReturnType>::func>
+  constexpr void operator()(const RetFunc &retFunc, Args &&...args) noexcept
+  {
+    static_assert(!std::is_void_v<ReturnType>, "Must have non-void return type!");
+
+    if (blocked()) return;
+
+    WaiterList waiting;
+    takeWaiters(waiting);
+    forEachEntry(
+      [&](Function function) { retFunc(function(std::forward<const Args>(args)...)); },
+      [&](const Slot &slot) { retFunc(slot(std::forward<const Args>(args)...)); },
+      [&](BasicSignal *sig) { (*sig)(retFunc, std::forward<Args>(args)...); },
+      [&](const BasicSignal &sig) { sig.takeWaiters(waiting); });
+    resumeWaiters(waiting, args...);
+  }
+
+  /// Emits the signal and returns the return values of the slots combined by \p combiner.
+  /** Unlike passing a function to operator(), the combiner is a template parameter and its result
+      is returned directly, so there is no type erasure involved. If the combiner has `done()`, the
+      emission stops invoking slots, including those of connected signals, once it returns true.
+
+      Example:
+        const auto values = signal.emit(sigs::collect::ToVector<int>(), 42);
+      */
+  template <Combiner<ReturnType> Comb>
+    requires(!std::is_void_v<ReturnType>)
+  [[nodiscard]] constexpr auto emit(Comb combiner, Args &&...args) noexcept
+  {
+    if constexpr (requires { combiner.reserve(std::size_t(0)); }) {
+      combiner.reserve(size());
+    }
+    combine(combiner, std::forward<Args>(args)...);
+    return std::move(combiner).result();
+  }
+
+  /// Like above with a combiner template instantiated for the return type, like
+  /// `signal.emit<sigs::collect::Sum>(42)`.
+  template <template <typename> class Comb>
+    requires(!std::is_void_v<ReturnType>)
+  [[nodiscard]] constexpr auto emit(Args &&...args) noexcept
+  {
+    return emit(Comb<ReturnType>(), std::forward<Args>(args)...);
+  }
+
+  /// Emits each event of \p batch, taking the lock or snapshot of the entries only once.
+  /** With BatchOrder::EventMajor each event is passed to all slots before the next one. Slots
+      connected via connectBatch() are invoked with the whole batch in connection order instead, so
+      the slots connected before one have received all events by then, and the ones connected after
+      it receive them afterwards. With
+      BatchOrder::SlotMajor each slot is invoked with all events before the next one, and connected
+      signals emit the whole batch in turn. Return values are ignored, and waiting coroutines are
+      resumed with the first event. */
+  void emitBatch(Batch batch, BatchOrder order = BatchOrder::EventMajor) noexcept
+  {
+    emitBatch(batch.begin(), batch.end(), order);
+  }
+
+  /// Like above for the events in [\p first, \p last), which are tuples of the arguments.
+  /** If slots connected via connectBatch() are reached and the events aren't stored contiguously
+      as `std::tuple<Args...>`, they are copied into a temporary batch. */
+  template <std::forward_iterator It>
+  void emitBatch(It first, It last, BatchOrder order = BatchOrder::EventMajor) noexcept
+  {
+    if (blocked() || first == last) return;
+
+    WaiterList waiting;
+    takeWaiters(waiting);
+    withEntries([&](const Cont &cont) {
+      // Slots are always invoked with lvalues, so arguments taken by value are copied for each.
+      auto emitEvent = [&](const auto &callable, const auto &event) {
+        std::apply([&](auto &&...values) { callable(values...); }, event);
+      };
+
+      Vector<std::tuple<Args...>> copy(allocator);
+      auto wholeBatch = [&]() -> Batch {
+        using Value = std::iter_value_t<It>;
+        if constexpr (std::contiguous_iterator<It> &&
+                      std::is_same_v<std::remove_cv_t<Value>, std::tuple<Args...>>) {
+          const auto count = static_cast<std::size_t>(std::distance(first, last));
+          return Batch(std::to_address(first), count);
+        }
+        else {
+          if (copy.empty()) {
+            for (auto it = first; it != last; ++it) {
+              copy.emplace_back(std::make_from_tuple<std::tuple<Args...>>(*it));
+            }
+          }
+          return Batch(copy);
+        }
+      };
+
+      // Epoch emission, and locked emission with a shared lock, skip entries disconnected
+      // meanwhile.
+      const auto skip = [&] {
+        if constexpr (epochEmission) {
+          return skipDisconnected(cont);
+        }
+        else if constexpr (lockedEmission) {
+          return skipMarked(cont);
+        }
+        else {
+          return [](std::size_t /*unused*/) { return false; };
+        }
+      }();
+
+      if (order == BatchOrder::SlotMajor) {
+        for (std::size_t i = 0; i < cont.size(); ++i) {
+          if (skip(i)) continue;
+
+          // Entries can be disabled by their own slots, see Emitter.
+          if (cont.functions[i]) {
+            for (auto it = first; it != last && cont.functions[i]; ++it) {
+              emitEvent(cont.functions[i], *it);
+            }
+          }
+          else if (const auto *batchSlot = cont.batchSlots[i]; batchSlot) {
+            (*batchSlot)(wholeBatch());
+          }
+          else if (const auto &slot = cont.slots[i]; slot) {
+            cont.whileAlive(cont.trackers[i], [&] {
+              for (auto it = first; it != last && slot; ++it) {
+                emitEvent(slot, *it);
+              }
+            });
+          }
+          else if (auto *sig = cont.signals[i]; sig) {
+            sig->emitBatch(first, last, order);
+          }
+        }
+        return;
+      }
+
+      // Each run of entries up to the next batch slot gets all events before the batch slot.
+      for (std::size_t begin = 0; begin < cont.size();) {
+        auto end = begin;
+        while (end < cont.size() && !cont.batchSlots[end]) {
+          ++end;
+        }
+
+        for (auto it = first; it != last; ++it) {
+          for (std::size_t i = begin; i < end; ++i) {
+            if (skip(i)) continue;
+
+            if (const auto function = cont.functions[i]; function) {
+              emitEvent(function, *it);
+            }
+            else if (const auto &slot = cont.slots[i]; slot) {
+              cont.whileAlive(cont.trackers[i], [&] { emitEvent(slot, *it); });
+            }
+            else if (auto *sig = cont.signals[i]; sig) {
+              std::apply([sig](auto &&...values) { (*sig)(static_cast<Args>(values)...); }, *it);
+            }
+          }
+        }
+
+        // The batch slot can be disabled by the slots before it, see Emitter.
+        if (end < cont.size()) {
+          if (const auto *batchSlot = cont.batchSlots[end]; batchSlot && !skip(end)) {
+            (*batchSlot)(wholeBatch());
+          }
+        }
+        begin = end + 1;
+      }
+    });
+
+    std::apply([&waiting](const auto &...values) { resumeWaiters(waiting, values...); }, *first);
+  }
+
+  /// Returns an awaitable that suspends the awaiting coroutine until the next emission and resumes
+  /// it with a copy of the arguments as a tuple, or with no value if the signal is destroyed first.
+  /** The coroutine is resumed by the emitting thread after the slots have been invoked. Emissions
+      that are already running when the coroutine starts waiting don't resume it. The coroutine may
+      be destroyed while waiting, but not while an emission resumes it.
+
+      Example:
+        auto [value] = *co_await signal.next();
+      */
+  [[nodiscard]] auto next() noexcept
+    requires awaitable
+  {
+    return Next<Inline>(this, nullptr);
+  }
+
+  /// Like above but the coroutine is resumed by a task of \p executor.
+  template <Executor Exec>
+    requires awaitable
+  [[nodiscard]] auto next(Exec &executor) noexcept
+  {
+    return Next<Exec>(this, &executor);
+  }
+
+  /// Returns a stream that buffers the arguments of each emission until a coroutine reads them.
+  /** Unlike awaiting next() repeatedly, no emission is missed while the coroutine is busy between
+      reads. The stream is connected as a slot until destroyed, so it resumes the reading coroutine
+      from within the emission like any slot.
+
+      Example:
+        auto stream = signal.stream();
+        for (;;) {
+          auto [value] = *co_await stream.next();
+        }
+      */
+  [[nodiscard]] Stream stream() noexcept
+    requires awaitable
+  {
+    return Stream(*this, [](std::coroutine_handle<> handle) { handle.resume(); });
+  }
+
+  /// Like above but the reading coroutine is resumed by a task of \p executor.
+  template <Executor Exec>
+    requires awaitable
+  [[nodiscard]] Stream stream(Exec &executor) noexcept
+  {
+    return Stream(*this, [&executor](std::coroutine_handle<> handle) {
+      executor.execute([handle] { handle.resume(); });
+    });
+  }
+
+  /// Invokes the slots concurrently on \p executor and returns once all of them have run.
+  /** The entries are split into chunks of Policy::parallelChunkSize entries, or evenly between the
+      executor and the emitting thread, which runs the last chunk itself. Slots of different chunks
+      run in no particular order and share the arguments, so both must be safe to use from several
+      threads at once. A connected signal is emitted as a whole by the chunk containing it. Slots
+      disconnected while emitting are skipped unless already running, like with operator(), and
+      slots run by the executor must not modify the signal with locked emission. Coroutines
+      awaiting next() are resumed once all slots have run. */
+  template <Executor Exec>
+  void emitParallel(Exec &executor, Args &&...args) noexcept
+  {
+    if (blocked()) return;
+
+    WaiterList waiting;
+    takeWaiters(waiting);
+    withEntries([&](const Cont &cont) {
+      forEachChunk(executor, cont, [&](std::size_t first, std::size_t count) {
+        cont.forEach([&](Function function) { function(std::forward<const Args>(args)...); },
+                     [&](const Slot &slot) { slot(std::forward<const Args>(args)...); },
+                     [&](BasicSignal *sig) { (*sig)(std::forward<Args>(args)...); },
+                     skipDisconnectedInParallel(cont), first, count);
+      });
+    });
+    resumeWaiters(waiting, args...);
+  }
+
+  /// Like above, but the return values are collected per chunk and passed to \p retFunc in
+  /// connection order on the emitting thread once all slots have run.
+  template <Executor Exec, typename RetFunc = typename detail::VoidableFunction<ReturnType>::func>
+  void emitParallel(Exec &executor, const RetFunc &retFunc, Args &&...args) noexcept
+  {
+    static_assert(!std::is_void_v<ReturnType>, "Must have non-void return type!");
+
+    if (blocked()) return;
+
+    WaiterList waiting;
+    takeWaiters(waiting);
+    withEntries([&](const Cont &cont) {
+      Vector<Vector<ReturnType>> results(chunkCount(executor, cont), Vector<ReturnType>(allocator),
+                                         allocator);
+      forEachChunk(executor, cont, [&](std::size_t first, std::size_t count) {
+        auto &chunkResults = results[first / chunkSize(executor, cont)];
+        auto collect = [&chunkResults](ReturnType value) {
+          chunkResults.emplace_back(std::move(value));
+        };
+        cont.forEach(
+          [&](Function function) { collect(function(std::forward<const Args>(args)...)); },
+          [&](const Slot &slot) { collect(slot(std::forward<const Args>(args)...)); },
+          [&](BasicSignal *sig) { (*sig)(collect, std::forward<Args>(args)...); },
+          skipDisconnectedInParallel(cont), first, count);
+      });
+
+      for (auto &chunkResults : results) {
+        for (auto &value : chunkResults) {
+          retFunc(std::move(value));
+        }
+      }
+    });
+    resumeWaiters(waiting, args...);
+  }
+
+  [[nodiscard]] constexpr std::unique_ptr<Interface> interface() noexcept
+  {
+    return std::make_unique<Interface>(this);
+  }
+
+  /// Returns the previous blocked state.
+  constexpr bool setBlocked(bool blocked)
+  {
+    const auto previous = blocked_.load();
+    blocked_ = blocked;
+    return previous;
+  }
+
+  constexpr bool blocked() const
+  {
+    return blocked_;
+  }
+
+  [[nodiscard]] Allocator get_allocator() const noexcept
+  {
+    return allocator;
+  }
+
+private:
+  [[nodiscard]] Connection makeConnection() noexcept
+  {
+    return Connection(ConnectionBase::make(
+      allocator, this,
+      [](void *sig, std::span<const ConnectionBase *const> conns) noexcept {
+        static_cast<BasicSignal *>(sig)->disconnectEntries(conns);
+      },
+      threadSafe));
+  }
+
+  void disconnectEntries(std::span<const ConnectionBase *const> conns) noexcept
+  {
+    if constexpr (lockedEmission) {
+      if (emitter.current()) {
+        deferDisconnect(conns);
+        return;
+      }
+    }
+
+    {
+      Lock lock(entriesMutex);
+      applyExitedDeferred();
+      const auto &current = currentEntries();
+      if (std::none_of(conns.begin(), conns.end(),
+                       [&current](const auto *conn) { return current.contains(conn); })) {
+        return;
+      }
+      modifyEntries([conns](Cont &cont) { cont.erase(conns); });
+    }
+    waitForEmissions();
+    reclaimEntries();
+  }
+
+  /// Disables the entries of \p conns and defers erasing them, see Emitter.
+  void deferDisconnect(std::span<const ConnectionBase *const> conns) noexcept
+  {
+    Vector<Connection> erased(allocator);
+    for (const auto *conn : conns) {
+      if (const auto index = entries.find(conn); index != Cont::npos) {
+        erased.push_back(entries.conns[index]);
+        disableEntry(index);
+      }
+      else if (auto added = emitter.findAdded(conn); added) {
+        erased.push_back(std::move(added));
+      }
+      else {
+        continue;
+      }
+      erased.back()->storeSignal(nullptr, std::memory_order_release);
+    }
+    if (erased.empty()) return;
+
+    emitter.defer([erased = std::move(erased)](Cont &cont) {
+      Vector<const ConnectionBase *> bases(cont.allocator());
+      for (const auto &conn : erased) {
+        bases.push_back(conn.get());
+      }
+      cont.erase(bases);
+    });
+  }
+
+  /// Disables the entry at \p index, or marks it with a shared lock, see Emitter.
+  /** Expects to be called by an emitting thread after marking its connection. */
+  void disableEntry(std::size_t index) noexcept
+  {
+    if constexpr (sharedLocking) {
+      emitter.marked.store(true, std::memory_order_relaxed);
+    }
+    else if (!emitter.parallel) {
+      entries.disable(index, emitter.retired);
+    }
+  }
+
+  /// Calls \p func with the entries while holding the entries lock, unless the calling thread is
+  /// already emitting, and applies the deferred modifications once its outermost emission exits.
+  template <typename Func>
+  void whileEmitting(Func &&func) noexcept
+  {
+    std::optional<ReadLock> lock;
+    if (!emitter.current()) {
+      lock.emplace(entriesMutex);
+    }
+
+    emitter.enter();
+    func(std::as_const(entries));
+    if (!emitter.exit() || !emitter.deferred.load(std::memory_order_relaxed)) return;
+
+    // Other threads can still be emitting with a shared lock, so the modifications wait for them.
+    if constexpr (sharedLocking) {
+      lock.reset();
+      Lock exclusive(entriesMutex);
+      applyDeferred();
+    }
+    else {
+      applyDeferred();
+    }
+  }
+
+  /// Expects entries container to be locked exclusively beforehand.
+  void applyDeferred() noexcept
+  {
+    decltype(emitter.pending) pending(emitter.pending.get_allocator());
+    {
+      std::scoped_lock lock(emitter.mutex);
+      pending.swap(emitter.pending);
+      emitter.added.clear();
+      emitter.deferred.store(false, std::memory_order_relaxed);
+    }
+    for (auto &modify : pending) {
+      modifyEntries(modify);
     }
+    emitter.marked.store(false, std::memory_order_relaxed);
+    emitter.retired.clear();
+  }
 
-    Lock lock(entriesMutex);
-    eraseEntries([conn](auto it) { return it->conn() == conn; });
+  /// Applies the modifications deferred by an emission with a shared lock that exited but waits
+  /// for the exclusive lock, so they aren't reordered with a later modification by another thread,
+  /// like disconnecting a connection that was made from a slot.
+  /** Expects entries container to be locked exclusively beforehand. */
+  void applyExitedDeferred() noexcept
+  {
+    if constexpr (sharedLocking) {
+      if (emitter.deferred.load(std::memory_order_relaxed)) {
+        applyDeferred();
+      }
+    }
   }
 
-  constexpr void disconnect(BasicSignal &signal) noexcept
+  /// Returns a predicate for Cont::forEach() that skips the entries disconnected while emitting
+  /// with a shared lock, see Emitter.
+  [[nodiscard]] auto skipMarked(const Cont &cont) const noexcept
   {
-    assert(&signal != this && "Disconnecting from self has no effect.");
+    if constexpr (sharedLocking) {
+      return [this, &cont](std::size_t index) {
+        if (!emitter.marked.load(std::memory_order_relaxed)) return false;
+        const auto &conn = cont.conns[index];
+        return conn && !conn->loadSignal(std::memory_order_relaxed);
+      };
+    }
+    else {
+      return [](std::size_t /*unused*/) { return false; };
+    }
+  }
+
+  /// Returns a predicate for Cont::forEach() that skips the entries of \p cont disconnected while
+  /// emitting it in parallel, like the one of the emission mode does otherwise.
+  /** With an exclusive lock the entries aren't disabled while the tasks read them, see Emitter, so
+      their connections are checked instead, which disconnecting clears. */
+  [[nodiscard]] auto skipDisconnectedInParallel(const Cont &cont) const noexcept
+  {
+    if constexpr (epochEmission) {
+      return skipDisconnected(cont);
+    }
+    else if constexpr (lockedEmission && !sharedLocking) {
+      return [&cont](std::size_t index) {
+        const auto &conn = cont.conns[index];
+        return conn && !conn->loadSignal(std::memory_order_relaxed);
+      };
+    }
+    else {
+      return skipMarked(cont);
+    }
+  }
+
+  /// Entries allocating with \p allocator_, which only holds a container with locked emission.
+  [[nodiscard]] static Entries makeEntries(const Allocator &allocator_) noexcept
+  {
+    if constexpr (lockedEmission) {
+      return Cont(allocator_);
+    }
+    else if constexpr (epochEmission) {
+      return Published(allocator_);
+    }
+    else {
+      return Entries();
+    }
+  }
 
-    Lock lock(entriesMutex);
-    eraseEntries([sig = &signal](auto it) { return it->signal() == sig; });
+  [[nodiscard]] static const Cont &noEntries() noexcept
+  {
+    static const Cont none;
+    return none;
   }
 
-  constexpr void operator()(Args &&...args) noexcept
+  /// Expects entries container to be locked beforehand.
+  [[nodiscard]] const Cont &currentEntries() const noexcept
+  {
+    if constexpr (snapshotEmission) {
+      return entries ? entries->cont : noEntries();
+    }
+    else if constexpr (epochEmission) {
+      const auto *cont = entries.cont.load(std::memory_order_relaxed);
+      return cont ? *cont : noEntries();
+    }
+    else {
+      return entries;
+    }
+  }
+
+  /// Expects entries container to be locked beforehand.
+  /** With snapshot emission the container is copied first if any emission is using it. With epoch
+      emission a modified copy is published and the previous container is retired, which must be
+      followed by reclaimEntries() after unlocking. Tracked slots whose object is gone are erased
+      along with the modification, see Cont::eraseExpired(). */
+  template <typename Func>
+  constexpr void modifyEntries(Func &&func) noexcept
+  {
+    [[maybe_unused]] Cont *previous = nullptr;
+    if constexpr (snapshotEmission) {
+      if (!entries) {
+        entries = std::allocate_shared<Snapshot>(allocator, Cont(allocator));
+      }
+      else if (entries->emissions.load(std::memory_order_acquire) > 0) {
+        entries = std::allocate_shared<Snapshot>(allocator, entries->cont);
+      }
+      else {
+        entries->plan.reset();
+      }
+      func(entries->cont);
+      entries->cont.eraseExpired();
+    }
+    else if constexpr (epochEmission) {
+      auto cont = makeUnique<Cont>(allocator, currentEntries(), allocator);
+      func(*cont);
+      cont->eraseExpired();
+      previous = entries.cont.exchange(cont.release());
+    }
+    else {
+      func(entries);
+      entries.eraseExpired();
+    }
+
+    // Bumped after publishing, so a plan recording the previous version is never taken as current.
+    entriesVersion.fetch_add(1);
+
+    // The epoch is advanced after bumping the version, so emissions entered from then on can't
+    // reach the previous container through a plan of another signal either.
+    if constexpr (epochEmission) {
+      if (previous) {
+        entries.retired.emplace_back(UniquePtr<Cont>(previous, Deleter{allocator}),
+                                     detail::EpochDomain::instance().advance());
+      }
+    }
+  }
+
+  /// Waits for the epoch emissions of this signal by other threads that started before the call,
+  /// so slots disconnected before aren't running anymore.
+  /** Emissions of other signals, including connected ones, aren't waited for unless they invoke
+      slots of this signal through their dispatch plan. Doesn't wait from within an epoch emission,
+      since two emitting threads disconnecting from each other's signal would deadlock. Expects the
+      entries container to be unlocked, since the slots waited for may lock it. */
+  void waitForEmissions() noexcept
+  {
+    if constexpr (epochEmission) {
+      if (!detail::EpochDomain::reading()) {
+        detail::EpochDomain::instance().synchronize(this);
+      }
+    }
+  }
+
+  /// Frees the containers and plans retired by epoch emission that no emission, including one of
+  /// the calling thread, can be using anymore.
+  /** Never waits for emissions, the others are kept until a later call or until the signal is
+      destroyed. Expects entries container to be unlocked, since freed slots may disconnect from
+      this signal when destroyed. */
+  void reclaimEntries() noexcept
+  {
+    if constexpr (epochEmission) {
+      const auto oldest = detail::EpochDomain::instance().oldest();
+      // Swaps the reclaimed objects into \p reclaimed, which is only moved and swapped since the
+      // deleters can't be assigned with allocators like `std::pmr::polymorphic_allocator`.
+      auto reclaim = [oldest](auto &retired, auto &reclaimed) {
+        auto reclaimable = [oldest](const auto &r) { return r.second <= oldest; };
+        if (std::all_of(std::begin(retired), std::end(retired), reclaimable)) {
+          reclaimed.swap(retired);
+          return;
+        }
+
+        std::remove_reference_t<decltype(retired)> kept(retired.get_allocator());
+        for (auto &r : retired) {
+          (reclaimable(r) ? reclaimed : kept).push_back(std::move(r));
+        }
+        retired.swap(kept);
+      };
+
+      decltype(entries.retired) retired(allocator);
+      decltype(entries.retiredPlans) retiredPlans(allocator);
+      {
+        Lock lock(entriesMutex);
+        reclaim(entries.retired, retired);
+        reclaim(entries.retiredPlans, retiredPlans);
+      }
+    }
+  }
+
+  /// Like operator() but passes the return values to \p combiner and stops once it's done.
+  template <typename Comb>
+  constexpr void combine(Comb &combiner, Args &&...args) noexcept
   {
     if (blocked()) return;
 
-    Lock lock(entriesMutex);
-    for (auto &entry : entries) {
-      if (auto *sig = entry.signal(); sig) {
-        (*sig)(std::forward<Args>(args)...);
+    WaiterList waiting;
+    takeWaiters(waiting);
+    forEachEntry(
+      [&](Function function) { combiner(function(std::forward<const Args>(args)...)); },
+      [&](const Slot &slot) { combiner(slot(std::forward<const Args>(args)...)); },
+      [&](BasicSignal *sig) { sig->combine(combiner, std::forward<Args>(args)...); },
+      [&](const BasicSignal &sig) { sig.takeWaiters(waiting); },
+      [&combiner] {
+        if constexpr (requires { combiner.done(); }) {
+          return static_cast<bool>(combiner.done());
+        }
+        else {
+          return false;
+        }
+      });
+    resumeWaiters(waiting, args...);
+  }
+
+  /// Invokes each entry, see Cont::forEach().
+  /** The entries lock is held during all calls unless snapshot or epoch emission is used, in which
+      case it is only held while taking a snapshot or not at all, respectively. Connected signals
+      are then invoked through the dispatch plan instead of recursively, and \p onEnter is called
+      with each of them that is reached. Once \p stop returns true after invoking an entry, the
+      remaining entries are skipped. */
+  template <typename OnFunction, typename OnSlot, typename OnSignal, typename OnEnter,
+            typename Stop = detail::NeverStop>
+  constexpr void forEachEntry(OnFunction &&onFunction, OnSlot &&onSlot, OnSignal &&onSignal,
+                              [[maybe_unused]] OnEnter &&onEnter, Stop &&stop = Stop()) noexcept
+  {
+    constexpr auto none = [](std::size_t /*unused*/) { return false; };
+
+    if constexpr (snapshotEmission) {
+      std::shared_ptr<Snapshot> snapshot;
+      std::shared_ptr<const Plan> plan;
+      std::uint64_t version = 0;
+      {
+        ReadLock lock(entriesMutex);
+        if (!entries) return;
+        snapshot = entries;
+        snapshot->emissions.fetch_add(1, std::memory_order_relaxed);
+        plan = snapshot->plan;
+        version = entriesVersion.load();
+      }
+
+      if (snapshot->cont.signalCount == 0) {
+        snapshot->cont.forEach(onFunction, onSlot, onSignal, none, stop);
       }
       else {
-        entry.slot()(std::forward<const Args>(args)...);
+        if (!plan || !plan->enter()) {
+          auto built = std::allocate_shared<Plan>(allocator, allocator);
+          Vector<const BasicSignal *> path(allocator);
+          expandPlan(*built, path, snapshot->cont, version, nullptr);
+          plan = built;
+
+          Lock lock(entriesMutex);
+          snapshot->plan = plan;
+        }
+        plan->forEach(onFunction, onSlot, onEnter, none, stop);
+        plan->leave();
+      }
+      snapshot->emissions.fetch_sub(1, std::memory_order_release);
+    }
+    else if constexpr (epochEmission) {
+      bool retiredPlan = false;
+      {
+        detail::EpochDomain::Guard guard(this);
+        const auto version = entriesVersion.load();
+        const auto *cont = entries.cont.load();
+        if (!cont) return;
+
+        if (cont->signalCount == 0) {
+          cont->forEach(onFunction, onSlot, onSignal, skipDisconnected(*cont), stop);
+          return;
+        }
+
+        const auto *plan = entries.plan.load();
+        if (!plan || !plan->current()) {
+          auto built = makeUnique<Plan>(allocator, allocator);
+          Vector<const BasicSignal *> path(allocator);
+          expandPlan(*built, path, *cont, version, nullptr);
+          plan = built.get();
+
+          Lock lock(entriesMutex);
+          if (const auto *previous = entries.plan.exchange(built.release()); previous) {
+            entries.retiredPlans.emplace_back(UniquePtr<const Plan>(previous, Deleter{allocator}),
+                                              detail::EpochDomain::instance().advance());
+            retiredPlan = true;
+          }
+        }
+
+        // Each member is checked for entries disconnected while emitting, like above, after
+        // announcing it so disconnecting from it waits for the slots invoked from then on.
+        const BasicSignal *announced = this;
+        plan->forEach(
+          onFunction, onSlot, onEnter,
+          [&](std::size_t index) {
+            const auto &member = plan->members[plan->owners[index]];
+            if (member.signal != announced) {
+              announced = member.signal;
+              guard.announce(announced);
+            }
+            const auto *current = member.signal->entries.cont.load();
+            if (current == member.cont) return false;
+            return !current->contains(member.cont->conns[plan->indices[index]].get());
+          },
+          stop);
+      }
+
+      // Plans are only retired when rebuilt after a member was modified, so free them, and the
+      // containers, that no emission uses anymore instead of waiting for this signal to be
+      // modified. This never waits for other emissions.
+      if (retiredPlan) {
+        reclaimEntries();
+      }
+    }
+    else {
+      whileEmitting([&](const Cont &cont) {
+        cont.forEach(onFunction, onSlot, onSignal, skipMarked(cont), stop);
+      });
+    }
+  }
+
+  /// Returns a predicate for Cont::forEach() that skips the entries disconnected since \p cont was
+  /// loaded, most notably by the slots themselves, with epoch emission.
+  /** The entries are looked up by their keys in the latest container, which is loaded sequentially
+      consistent after the emission was announced, see detail::EpochDomain::Guard. */
+  [[nodiscard]] auto skipDisconnected(const Cont &cont) const noexcept
+  {
+    return [this, &cont](std::size_t index) {
+      const auto *current = entries.cont.load();
+      return current != &cont && !current->contains(cont.conns[index].get());
+    };
+  }
+
+  /// Records that \p conn connects \p signal to this one, unless this signal can be reached from
+  /// \p signal, and returns whether it did.
+  bool connectAcyclic(const BasicSignal &signal, const Connection &conn) noexcept
+  {
+    std::scoped_lock lock(detail::signalGraphMutex());
+    Vector<const BasicSignal *> visited(allocator);
+    if (signal.reaches(*this, visited)) return false;
+
+    connectedSignals.emplace_back(&signal, conn);
+    return true;
+  }
+
+  /// Whether \p target is this signal or can be reached through the signals it's connected to.
+  /** Expects detail::signalGraphMutex() to be locked beforehand. Signals disconnected meanwhile
+      are dropped on the way. \p visited holds the signals already checked. */
+  [[nodiscard]] bool reaches(const BasicSignal &target,
+                             Vector<const BasicSignal *> &visited) const noexcept
+  {
+    if (this == &target) return true;
+    if (std::find(visited.begin(), visited.end(), this) != visited.end()) return false;
+    visited.push_back(this);
+
+    std::erase_if(connectedSignals, [](const auto &connected) {
+      return !connected.second->loadSignal(std::memory_order_acquire);
+    });
+    return std::any_of(
+      connectedSignals.begin(), connectedSignals.end(),
+      [&](const auto &connected) { return connected.first->reaches(target, visited); });
+  }
+
+  /// Adds the entries of \p cont, which is the container of this signal at \p version, to \p plan
+  /// and expands the connected signals in place.
+  /** \p path holds the signals currently being expanded, none of which is reached again since
+      connect() rejects connections closing a cycle. With snapshot emission \p snapshot keeps
+      \p cont alive if it isn't already kept alive by the emission. */
+  void expandPlan(Plan &plan, Vector<const BasicSignal *> &path, const Cont &cont,
+                  std::uint64_t version, std::shared_ptr<Snapshot> snapshot) const noexcept
+  {
+    const auto owner = std::size(plan.members);
+    plan.members.push_back({this, version, &cont, std::move(snapshot)});
+
+    path.push_back(this);
+    for (std::size_t i = 0; i < cont.size(); ++i) {
+      if (!cont.conns[i]) continue;
+
+      const auto *signal = cont.signals[i];
+      if (!signal) {
+        const auto &slot = cont.slots[i];
+        plan.add(cont.functions[i], slot ? &slot : nullptr, cont.trackers[i], nullptr, owner, i);
+        continue;
+      }
+
+      assert(std::find(path.begin(), path.end(), signal) == path.end() &&
+             "Connected signals must not form a cycle.");
+
+      const auto index = plan.size();
+      plan.add(nullptr, nullptr, nullptr, signal, owner, i);
+      signal->expandPlan(plan, path);
+      plan.ends[index] = plan.size();
+    }
+    path.pop_back();
+  }
+
+  /// Adds the current entries of this signal to \p plan, see expandPlan() above.
+  /** With snapshot emission the snapshot is counted as emitting, like by Plan::enter(). */
+  void expandPlan(Plan &plan, Vector<const BasicSignal *> &path) const noexcept
+  {
+    if constexpr (snapshotEmission) {
+      std::shared_ptr<Snapshot> snapshot;
+      std::uint64_t version = 0;
+      {
+        ReadLock lock(entriesMutex);
+        version = entriesVersion.load();
+        if (entries) {
+          snapshot = entries;
+          snapshot->emissions.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      const auto &cont = snapshot ? snapshot->cont : noEntries();
+      expandPlan(plan, path, cont, version, std::move(snapshot));
+    }
+    else {
+      // Loaded in the reverse order of modifyEntries(), so the version is never newer than the
+      // container.
+      const auto version = entriesVersion.load();
+      const auto *cont = entries.cont.load();
+      expandPlan(plan, path, cont ? *cont : noEntries(), version, nullptr);
+    }
+  }
+
+  /// Calls \p func with the current entries, which stay valid and unmodified during the call.
+  /** The entries lock is held during the call unless snapshot or epoch emission is used, see
+      forEachEntry(). */
+  template <typename Func>
+  void withEntries(Func &&func) noexcept
+  {
+    if constexpr (snapshotEmission) {
+      std::shared_ptr<Snapshot> snapshot;
+      {
+        ReadLock lock(entriesMutex);
+        if (!entries) return;
+        snapshot = entries;
+        snapshot->emissions.fetch_add(1, std::memory_order_relaxed);
+      }
+      func(std::as_const(snapshot->cont));
+      snapshot->emissions.fetch_sub(1, std::memory_order_release);
+    }
+    else if constexpr (epochEmission) {
+      detail::EpochDomain::Guard guard(this);
+      if (const auto *cont = entries.cont.load(); cont) {
+        func(*cont);
+      }
+    }
+    else {
+      whileEmitting(func);
+    }
+  }
+
+  template <typename Exec>
+  [[nodiscard]] static std::size_t chunkSize(Exec &executor, const Cont &cont) noexcept
+  {
+    if constexpr (Policy::parallelChunkSize > 0) {
+      return Policy::parallelChunkSize;
+    }
+    const auto chunks = static_cast<std::size_t>(executor.concurrency()) + 1;
+    const auto size = (cont.size() + chunks - 1) / chunks;
+    return size > 0 ? size : 1;
+  }
+
+  template <typename Exec>
+  [[nodiscard]] static std::size_t chunkCount(Exec &executor, const Cont &cont) noexcept
+  {
+    const auto size = chunkSize(executor, cont);
+    return (cont.size() + size - 1) / size;
+  }
+
+  /// Calls \p func with the index range of each chunk of \p cont, all but the last one as tasks
+  /// of \p executor, and waits for all of them to finish.
+  template <typename Exec, typename Func>
+  void forEachChunk(Exec &executor, const Cont &cont, Func &&func) noexcept
+  {
+    const auto chunks = chunkCount(executor, cont);
+    if (chunks == 0) return;
+
+    // Entries must not be disabled while the tasks read them, see Emitter.
+    [[maybe_unused]] bool parallel = false;
+    if constexpr (lockedEmission && !sharedLocking) {
+      parallel = std::exchange(emitter.parallel, true);
+    }
+
+    const auto size = chunkSize(executor, cont);
+    const auto count = cont.size();
+    std::latch done(static_cast<std::ptrdiff_t>(chunks - 1));
+    for (std::size_t first = 0; first + size < count; first += size) {
+      executor.execute([&func, &done, first, size] {
+        func(first, first + size);
+        done.count_down();
+      });
+    }
+    func((chunks - 1) * size, count);
+    done.wait();
+    if constexpr (lockedEmission && !sharedLocking) {
+      emitter.parallel = parallel;
+    }
+  }
+
+  /// Expects both entries containers to be locked beforehand.
+  constexpr void copyEntries(const BasicSignal &rhs) noexcept
+  {
+    modifyEntries([&rhs](Cont &cont) { cont = rhs.currentEntries(); });
+  }
+
+  void copyConnectedSignals(const BasicSignal &rhs) noexcept
+  {
+    std::scoped_lock lock(detail::signalGraphMutex());
+    connectedSignals.assign(rhs.connectedSignals.begin(), rhs.connectedSignals.end());
+  }
+
+  void addEntry(Connection conn, Function function, Slot &&slot = {},
+                BasicSignal *signal = nullptr, const BatchSlot *batchSlot = nullptr,
+                const Tracker *tracker = nullptr) noexcept
+  {
+    if constexpr (lockedEmission) {
+      if (emitter.current()) {
+        emitter.defer(
+          [conn, function, slot = std::move(slot), signal, batchSlot,
+           tracker](Cont &cont) mutable {
+            cont.add(std::move(conn), function, std::move(slot), signal, batchSlot, tracker);
+          },
+          conn);
+        return;
+      }
+    }
+
+    {
+      Lock lock(entriesMutex);
+      applyExitedDeferred();
+      modifyEntries([&](Cont &cont) {
+        cont.add(std::move(conn), function, std::move(slot), signal, batchSlot, tracker);
+      });
+    }
+    reclaimEntries();
+  }
+
+  /// Erases the entries at the indices matching \p pred, or disables them and defers erasing them
+  /// while emitting, see Emitter.
+  /** The deferred erasure also erases the matching entries added by modifications deferred
+      before. */
+  template <typename Pred>
+  constexpr void eraseEntries(Pred pred) noexcept
+  {
+    if constexpr (lockedEmission) {
+      if (emitter.current()) {
+        Vector<const ConnectionBase *> erased(allocator);
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+          // Entries disconnected by a pending modification may be freed before this one applies.
+          const auto &conn = entries.conns[i];
+          if (conn && conn->loadSignal(std::memory_order_relaxed) &&
+              pred(std::as_const(entries), i)) {
+            conn->storeSignal(nullptr, std::memory_order_release);
+            erased.push_back(conn.get());
+            disableEntry(i);
+          }
+        }
+        emitter.defer([erased = std::move(erased), pred](Cont &cont) {
+          cont.erase(erased);
+          cont.eraseIf(pred);
+        });
+        return;
       }
     }
+
+    {
+      Lock lock(entriesMutex);
+      applyExitedDeferred();
+      modifyEntries([&pred](Cont &cont) { cont.eraseIf(pred); });
+    }
+    waitForEmissions();
+    reclaimEntries();
+  }
+
+  [[no_unique_address]] Allocator allocator;
+  Entries entries;
+  [[no_unique_address]] mutable Mutex entriesMutex;
+
+  /// Incremented on each modification of the entries to invalidate dispatch plans.
+  detail::Atomic<std::uint64_t, threadSafe> entriesVersion = 0;
+
+  /// Only used with locked emission.
+  Emitter emitter;
+
+  /// Coroutines waiting for the next emission, resumed in the order they started waiting.
+  mutable WaiterList waiters;
+
+  /// Signals this one is connected to, and the connections, which are only accessed while holding
+  /// detail::signalGraphMutex(), see connect(BasicSignal &).
+  mutable Vector<std::pair<const BasicSignal *, Connection>> connectedSignals;
+
+  /// States of the streams of the signal, closed once it's destroyed.
+  WaiterList streams;
+
+  detail::Atomic<bool, threadSafe> blocked_ = false;
+};
+
+/// Signal whose slots are fixed at compile-time.
+/** The slots are given as constant template arguments, like functions or captureless lambdas, and
+    emitting the signal calls each of them in order. There is no container, lock, or type erasure
+    involved, so the compiler can inline the whole emission.
+
+    Example:
+      sigs::StaticSignal<void(int), &log, &record> s;
+      s(42);
+    */
+template <typename Ret, typename... Args, auto... Slots>
+class StaticSignal<Ret(Args...), Slots...> {
+  static_assert((std::is_invocable_r_v<Ret, decltype(Slots), Args...> && ...),
+                "Slots must be invocable with the arguments and return type of the signal!");
+
+public:
+  using RetArgs = Ret(Args...);
+  using ReturnType = Ret;
+
+  constexpr StaticSignal() noexcept = default;
+  constexpr virtual ~StaticSignal() noexcept = default;
+
+  constexpr StaticSignal(const StaticSignal &rhs) noexcept : blocked_(rhs.blocked_.load())
+  {
+  }
+
+  constexpr StaticSignal &operator=(const StaticSignal &rhs) noexcept
+  {
+    blocked_ = rhs.blocked_.load();
+    return *this;
+  }
+
+  [[nodiscard]] static constexpr std::size_t size() noexcept
+  {
+    return sizeof...(Slots);
+  }
+
+  [[nodiscard]] static constexpr bool empty() noexcept
+  {
+    return 0 == size();
+  }
+
+  constexpr void operator()(Args &&...args) noexcept
+  {
+    if (blocked()) return;
+
+    (std::invoke(Slots, std::forward<const Args>(args)...), ...);
   }
 
   template <typename RetFunc = typename detail::VoidableFunction<ReturnType>::func>
@@ -437,20 +4346,38 @@ public:
 
     if (blocked()) return;
 
-    Lock lock(entriesMutex);
-    for (auto &entry : entries) {
-      if (auto *sig = entry.signal(); sig) {
-        (*sig)(retFunc, std::forward<Args>(args)...);
-      }
-      else {
-        retFunc(entry.slot()(std::forward<const Args>(args)...));
-      }
+    (retFunc(std::invoke(Slots, std::forward<const Args>(args)...)), ...);
+  }
+
+  /// Emits the signal and returns the return values of the slots combined by \p combiner, see
+  /// BasicSignal::emit().
+  template <Combiner<ReturnType> Comb>
+    requires(!std::is_void_v<ReturnType>)
+  [[nodiscard]] constexpr auto emit(Comb combiner, Args &&...args) noexcept
+  {
+    if constexpr (requires { combiner.reserve(std::size_t(0)); }) {
+      combiner.reserve(size());
+    }
+    if (blocked()) return std::move(combiner).result();
+
+    if constexpr (requires { combiner.done(); }) {
+      auto invoke = [&](auto slot) {
+        combiner(std::invoke(slot, std::forward<const Args>(args)...));
+        return !combiner.done();
+      };
+      (invoke(Slots) && ...);
+    }
+    else {
+      (combiner(std::invoke(Slots, std::forward<const Args>(args)...)), ...);
     }
+    return std::move(combiner).result();
   }
 
-  [[nodiscard]] constexpr std::unique_ptr<Interface> interface() noexcept
+  template <template <typename> class Comb>
+    requires(!std::is_void_v<ReturnType>)
+  [[nodiscard]] constexpr auto emit(Args &&...args) noexcept
   {
-    return std::make_unique<Interface>(this);
+    return emit(Comb<ReturnType>(), std::forward<Args>(args)...);
   }
 
   /// Returns the previous blocked state.
@@ -467,62 +4394,183 @@ public:
   }
 
 private:
-  [[nodiscard]] Connection makeConnection() noexcept
+  std::atomic_bool blocked_ = false;
+};
+
+/// Mutex that spins with exponential backoff before parking the thread, which suits the short
+/// critical sections of signals.
+/** Connecting, disconnecting, and querying a signal only hold its lock for tens of nanoseconds, so
+    a contended `std::mutex` often puts a thread to sleep in the kernel while the lock is released
+    right away. This mutex first spins, pausing the CPU for exponentially longer between attempts,
+    and only then parks the thread on a futex on Linux, or via `std::atomic::wait()` elsewhere.
+    Unlocking only enters the kernel if a thread is parked. */
+class SpinFutexMutex final {
+public:
+  SpinFutexMutex() noexcept = default;
+
+  SpinFutexMutex(const SpinFutexMutex &) = delete;
+  SpinFutexMutex &operator=(const SpinFutexMutex &) = delete;
+
+  void lock() noexcept
   {
-    auto conn = std::make_shared<ConnectionBase>();
-    conn->deleter = [this, conn] { this->disconnect(conn); };
-    return conn;
+    for (std::uint32_t pauses = 1; pauses <= maxPauses; pauses *= 2) {
+      if (state.load(std::memory_order_relaxed) == unlocked && try_lock()) return;
+      for (std::uint32_t i = 0; i < pauses; ++i) {
+        pause();
+      }
+    }
+
+    // Marks the mutex as having parked threads before parking, so unlock() wakes one of them.
+    while (state.exchange(parked, std::memory_order_acquire) != unlocked) {
+      wait();
+    }
   }
 
-  /// Expects entries container to be locked beforehand.
-  [[nodiscard]] constexpr typename Cont::iterator eraseEntry(typename Cont::iterator it) noexcept
+  [[nodiscard]] bool try_lock() noexcept
   {
-    auto conn = it->conn();
-    if (conn) {
-      conn->deleter = nullptr;
+    auto expected = unlocked;
+    return state.compare_exchange_strong(expected, locked, std::memory_order_acquire,
+                                         std::memory_order_relaxed);
+  }
+
+  void unlock() noexcept
+  {
+    if (state.exchange(unlocked, std::memory_order_release) == parked) {
+      wake();
     }
-    return entries.erase(it);
   }
 
-  constexpr void eraseEntries(std::function<bool(typename Cont::iterator)> pred =
-                                [](auto /*unused*/) { return true; }) noexcept
+  /// Whether a thread stopped spinning and is parked, or about to park, waiting for the mutex.
+  [[nodiscard]] bool contended() const noexcept
   {
-    for (auto it = entries.begin(); it != entries.end();) {
-      if (pred(it)) {
-        it = eraseEntry(it);
-      }
-      else {
-        ++it;
-      }
+    return state.load(std::memory_order_relaxed) == parked;
+  }
+
+private:
+  static constexpr std::uint32_t unlocked = 0, locked = 1, parked = 2;
+
+  /// Pauses between the last attempts of spinning, which sum up to 127 pauses in total.
+  static constexpr std::uint32_t maxPauses = 64;
+
+  static void pause() noexcept
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+  }
+
+  void wait() noexcept
+  {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&state), FUTEX_WAIT_PRIVATE, parked,
+            nullptr, nullptr, 0);
+#else
+    state.wait(parked, std::memory_order_relaxed);
+#endif
+  }
+
+  void wake() noexcept
+  {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&state), FUTEX_WAKE_PRIVATE, 1, nullptr,
+            nullptr, 0);
+#else
+    state.notify_one();
+#endif
+  }
+
+  // The futex system call takes the address of the integer.
+  static_assert(sizeof(std::atomic_uint32_t) == sizeof(std::uint32_t));
+  std::atomic_uint32_t state = unlocked;
+};
+
+/// Mutex that doesn't synchronize anything, for signals that are only used by one thread.
+/** Locking it is a no-op, except that without `NDEBUG` the first thread locking it becomes its
+    owner for good, and locking it from any other thread afterwards fails an assertion. This catches
+    a single-threaded signal being shared by threads, even if they never use it concurrently. */
+class NullMutex final {
+public:
+  NullMutex() noexcept = default;
+
+  NullMutex(const NullMutex &) = delete;
+  NullMutex &operator=(const NullMutex &) = delete;
+
+  void lock() noexcept
+  {
+#ifndef NDEBUG
+    const auto self = std::this_thread::get_id();
+    auto first = std::thread::id();
+    if (!owner.compare_exchange_strong(first, self, std::memory_order_relaxed)) {
+      assert(first == self && "Single-threaded signal used by another thread.");
     }
+#endif
   }
 
-  template <typename Instance, typename MembFunc, std::size_t... Ns>
-  [[nodiscard]] constexpr Slot bindMf(Instance *instance, MembFunc Instance::*mf,
-                                      Seq<Ns...> /*unused*/) noexcept
+  [[nodiscard]] bool try_lock() noexcept
   {
-    return std::bind(mf, instance, Placeholder<Ns>()...);
+    lock();
+    return true;
   }
 
-  template <typename Instance, typename MembFunc>
-  [[nodiscard]] constexpr Slot bindMf(Instance *instance, MembFunc Instance::*mf) noexcept
+  void unlock() noexcept
   {
-    return bindMf(instance, mf, MakeSeq<sizeof...(Args)>());
   }
 
-  Cont entries;
-  mutable Mutex entriesMutex;
-  std::atomic_bool blocked_ = false;
+private:
+#ifndef NDEBUG
+  /// Thread that locked the mutex first, which is atomic so that two threads locking it for the
+  /// first time at once can't both become the owner.
+  std::atomic<std::thread::id> owner;
+#endif
 };
 
 using BasicLock = std::scoped_lock<std::mutex>;
 
+/// Lock of signals that are only used by one thread, see NullMutex and SignalST.
+using NullLock = std::scoped_lock<NullMutex>;
+
+/// Lock of signals whose lock is briefly contended by many threads, see SpinFutexMutex.
+using SpinFutexLock = std::scoped_lock<SpinFutexMutex>;
+
+/// Lock whose mutex emissions lock shared, see BasicSignal::ReadLock.
+using SharedLock = std::scoped_lock<std::shared_mutex>;
+
 /// Default signal types.
 //@{
 
 template <typename T>
 using Signal = BasicSignal<T, BasicLock>;
 
+/// Signal that invokes its slots on snapshots, see Emission::Snapshot.
+template <typename T>
+using SnapshotSignal = BasicSignal<T, BasicLock, SnapshotPolicy>;
+
+/// Signal that invokes its slots protected by epoch-based reclamation, see Emission::Epoch.
+template <typename T>
+using EpochSignal = BasicSignal<T, BasicLock, EpochPolicy>;
+
+/// Signal whose emissions only take its lock shared, so emissions from several threads invoke the
+/// slots in parallel while connecting and disconnecting still wait for them.
+template <typename T>
+using SharedSignal = BasicSignal<T, SharedLock>;
+
+/// Signal whose lock spins briefly before parking the thread, see SpinFutexMutex.
+template <typename T>
+using FastSignal = BasicSignal<T, SpinFutexLock>;
+
+/// Signal that must only be used by one thread, which neither locks nor uses atomic variables,
+/// see DefaultPolicy::threadSafe and NullMutex.
+template <typename T>
+using SignalST = BasicSignal<T, NullLock, SingleThreadPolicy>;
+
+/// Signal allocating from a `std::pmr::memory_resource` given when constructing it, see PmrPolicy.
+template <typename T>
+using PmrSignal = BasicSignal<T, BasicLock, PmrPolicy>;
+
 //@}
 
 } // namespace sigs
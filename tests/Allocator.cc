@@ -0,0 +1,376 @@
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+namespace {
+
+/// Memory resource counting the allocations it serves from the default resource.
+class CountingResource : public std::pmr::memory_resource {
+public:
+  std::size_t allocations = 0, deallocations = 0;
+
+  [[nodiscard]] std::size_t outstanding() const
+  {
+    return allocations - deallocations;
+  }
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override
+  {
+    deallocations++;
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+/// Callable that is too large to be stored inline.
+auto largeSlot(int &calls)
+{
+  std::array<char, 64> padding{};
+  return [&calls, padding](int i) { calls += i + padding[0]; };
+}
+
+int outstandingAllocations = 0;
+
+/// Minimal allocator that counts the outstanding allocations of all its instances.
+template <typename T>
+class CountingAllocator {
+public:
+  using value_type = T;
+
+  CountingAllocator() noexcept = default;
+
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> & /*unused*/) noexcept
+  {
+  }
+
+  T *allocate(std::size_t n)
+  {
+    outstandingAllocations++;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *ptr, std::size_t n) noexcept
+  {
+    outstandingAllocations--;
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U> & /*unused*/) const noexcept
+  {
+    return true;
+  }
+};
+
+struct CountingPolicy : sigs::DefaultPolicy {
+  using Allocator = CountingAllocator<std::byte>;
+};
+
+} // namespace
+
+TEST(Allocator, pmrSignal)
+{
+  CountingResource resource;
+  int calls = 0;
+  {
+    sigs::PmrSignal<void(int)> s(&resource);
+    EXPECT_EQ(s.get_allocator().resource(), &resource);
+
+    const auto conn = s.connect(largeSlot(calls));
+    s.connect([&calls](int i) { calls += i; });
+    EXPECT_GT(resource.allocations, 0);
+
+    s(1);
+    EXPECT_EQ(calls, 2);
+
+    s.disconnect(conn);
+    s(1);
+    EXPECT_EQ(calls, 3);
+  }
+  EXPECT_EQ(resource.outstanding(), 0);
+}
+
+TEST(Allocator, defaultResourceUnused)
+{
+  CountingResource resource, defaultResource;
+  auto *previous = std::pmr::set_default_resource(&defaultResource);
+  int calls = 0;
+  {
+    sigs::PmrSignal<void(int)> s(&resource);
+
+    // Callables are stored in slots allocating from the resource of the signal right away.
+    s.connect(largeSlot(calls));
+    auto owner = std::make_shared<int>(0);
+    s.connect(std::weak_ptr(owner), largeSlot(calls));
+    s.interface()->connect(largeSlot(calls));
+
+    s(1);
+    EXPECT_EQ(calls, 3);
+  }
+  std::pmr::set_default_resource(previous);
+  EXPECT_EQ(defaultResource.allocations, 0);
+  EXPECT_EQ(resource.outstanding(), 0);
+}
+
+TEST(Allocator, slotMovedIntoResource)
+{
+  CountingResource resource, resource2, defaultResource;
+  auto *previous = std::pmr::set_default_resource(&defaultResource);
+  int calls = 0;
+  {
+    sigs::PmrSignal<void(int)> s(&resource);
+
+    // A slot allocated by another resource is copied into the resource of the signal.
+    sigs::PmrSignal<void(int)>::SlotType slot(largeSlot(calls), &resource2);
+    ASSERT_TRUE(slot.allocated());
+    const auto before = resource.allocations;
+    s.connect(std::move(slot));
+    EXPECT_GE(resource.allocations, before + 2);
+    EXPECT_EQ(resource2.outstanding(), 0);
+
+    s(1);
+    EXPECT_EQ(calls, 1);
+  }
+  std::pmr::set_default_resource(previous);
+  EXPECT_EQ(defaultResource.allocations, 0);
+  EXPECT_EQ(resource.outstanding(), 0);
+}
+
+TEST(Allocator, connectionOutlivesSignal)
+{
+  CountingResource resource;
+  sigs::Connection conn;
+  {
+    sigs::PmrSignal<void()> s(&resource);
+    conn = s.connect([] {});
+  }
+  EXPECT_EQ(resource.outstanding(), 1);
+  conn = nullptr;
+  EXPECT_EQ(resource.outstanding(), 0);
+}
+
+TEST(Allocator, internalSlots)
+{
+  CountingResource resource;
+  {
+    sigs::PmrSignal<void(int)> s(&resource);
+    auto owner = std::make_shared<int>(0);
+    int calls = 0, batches = 0;
+    s.connect(std::weak_ptr(owner), [&calls](int /*unused*/) { calls++; });
+    s.connectBatch([&batches](auto /*unused*/) { batches++; });
+
+    const auto before = resource.allocations;
+    s(1);
+    s.emitBatch(std::vector<std::tuple<int>>{{1}, {2}});
+    EXPECT_EQ(resource.allocations, before);
+    EXPECT_EQ(calls, 3);
+    EXPECT_EQ(batches, 2);
+  }
+  EXPECT_EQ(resource.outstanding(), 0);
+}
+
+TEST(Allocator, copy)
+{
+  CountingResource resource, resource2;
+  sigs::PmrSignal<void(int)> s(&resource);
+  int calls = 0;
+  s.connect(largeSlot(calls));
+
+  // Copies allocate from the default resource, like the standard containers.
+  decltype(s) s2(s);
+  EXPECT_EQ(s2.get_allocator().resource(), std::pmr::get_default_resource());
+
+  // Assigning keeps the resource of the signal assigned to.
+  sigs::PmrSignal<void(int)> s3(&resource2);
+  s3 = s;
+  EXPECT_EQ(s3.get_allocator().resource(), &resource2);
+  EXPECT_GT(resource2.allocations, 0);
+
+  s.clear();
+  s3(1);
+  EXPECT_EQ(calls, 1);
+}
+
+namespace {
+
+struct PmrSnapshotPolicy : sigs::PmrPolicy {
+  static constexpr sigs::Emission emission = sigs::Emission::Snapshot;
+};
+
+struct PmrEpochPolicy : sigs::PmrPolicy {
+  static constexpr sigs::Emission emission = sigs::Emission::Epoch;
+};
+
+template <typename Policy>
+void emissionModes()
+{
+  CountingResource resource;
+  {
+    sigs::BasicSignal<void(int), sigs::BasicLock, Policy> s(&resource);
+    int calls = 0;
+    sigs::Connection conn;
+    conn = s.connect([&](int i) {
+      calls += i;
+      conn->disconnect();
+    });
+    s.connect(largeSlot(calls));
+
+    const auto before = resource.allocations;
+    s(1);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(s.size(), 1);
+    EXPECT_GT(resource.allocations, before);
+  }
+  EXPECT_EQ(resource.outstanding(), 0);
+}
+
+} // namespace
+
+TEST(Allocator, snapshotEmission)
+{
+  emissionModes<PmrSnapshotPolicy>();
+}
+
+TEST(Allocator, epochEmission)
+{
+  emissionModes<PmrEpochPolicy>();
+}
+
+// Deferred modifications, containers published to epoch emissions, dispatch plans, and queued
+// events allocate from the resource of the signal too.
+TEST(Allocator, internalStructures)
+{
+  CountingResource resource, defaultResource;
+  auto *previous = std::pmr::set_default_resource(&defaultResource);
+  int calls = 0;
+  {
+    sigs::PmrSignal<void(int)> locked(&resource);
+    sigs::Connection conn;
+    conn = locked.connect([&](int i) {
+      calls += i;
+      locked.connect(largeSlot(calls));
+      conn->disconnect();
+    });
+    locked(1);
+    EXPECT_EQ(calls, 1);
+
+    sigs::EventLoop loop;
+    locked.connect(loop, [&calls](int i) { calls += i; }, 1);
+    locked(1);
+    locked(1);
+    EXPECT_EQ(loop.drain(), 2);
+    EXPECT_EQ(calls, 5);
+
+    sigs::BasicSignal<void(int), sigs::BasicLock, PmrSnapshotPolicy> snapshot(&resource),
+      snapshotChained(&resource);
+    sigs::BasicSignal<void(int), sigs::BasicLock, PmrEpochPolicy> epoch(&resource),
+      epochChained(&resource);
+    snapshot.connect(snapshotChained);
+    epoch.connect(epochChained);
+    snapshotChained.connect(largeSlot(calls));
+    epochChained.connect(largeSlot(calls));
+    snapshot(1);
+    epoch(1);
+    EXPECT_EQ(calls, 7);
+
+    // The plans are rebuilt after modifying the chained signals.
+    snapshotChained.connect([&calls](int i) { calls += i; });
+    epochChained.connect([&calls](int i) { calls += i; });
+    snapshot(1);
+    epoch(1);
+    EXPECT_EQ(calls, 11);
+  }
+  std::pmr::set_default_resource(previous);
+  EXPECT_EQ(defaultResource.allocations, 0);
+  EXPECT_EQ(resource.outstanding(), 0);
+}
+
+// A cached plan doesn't keep the chained signals from being modified in place between emissions,
+// so disconnecting from one allocates like disconnecting from a signal that isn't chained.
+TEST(Allocator, snapshotChainedModifiedInPlace)
+{
+  CountingResource resource;
+  int calls = 0;
+  sigs::BasicSignal<void(int), sigs::BasicLock, PmrSnapshotPolicy> s(&resource), chained(&resource),
+    unchained(&resource);
+  s.connect(chained);
+  chained.connect(largeSlot(calls));
+  unchained.connect(largeSlot(calls));
+  auto conn1 = chained.connect([&calls](int i) { calls += i; });
+  auto conn2 = unchained.connect([&calls](int i) { calls += i; });
+  s(1);
+  unchained(1);
+  EXPECT_EQ(calls, 4);
+
+  auto allocations = resource.allocations;
+  conn2->disconnect();
+  const auto unchainedAllocations = resource.allocations - allocations;
+
+  allocations = resource.allocations;
+  conn1->disconnect();
+  EXPECT_EQ(resource.allocations - allocations, unchainedAllocations);
+
+  // The plan is rebuilt after the modification.
+  s(1);
+  EXPECT_EQ(calls, 5);
+}
+
+TEST(Allocator, customAllocator)
+{
+  {
+    sigs::BasicSignal<void(int), sigs::BasicLock, CountingPolicy> s;
+    int calls = 0;
+    s.connect(largeSlot(calls));
+    s.connect([&calls](int i) { calls += i; });
+    EXPECT_GT(outstandingAllocations, 0);
+
+    s(1);
+    EXPECT_EQ(calls, 2);
+  }
+  EXPECT_EQ(outstandingAllocations, 0);
+}
+
+TEST(Allocator, delegate)
+{
+  CountingResource resource;
+  const std::string text(100, 'x');
+  {
+    sigs::Delegate<std::size_t(), 32, std::pmr::polymorphic_allocator<std::byte>> d(
+      [text] { return text.size(); }, &resource);
+    ASSERT_TRUE(d.allocated());
+    EXPECT_EQ(resource.allocations, 1);
+
+    // Copies allocate from the default resource unless one is given.
+    const decltype(d) copy(d);
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    const decltype(d) copy2(d, &resource);
+    EXPECT_EQ(resource.allocations, 2);
+
+    // Moving within the same resource doesn't allocate.
+    decltype(d) moved(std::move(d), &resource);
+    EXPECT_EQ(resource.allocations, 2);
+    EXPECT_EQ(moved(), 100);
+    EXPECT_EQ(copy2(), 100);
+  }
+  EXPECT_EQ(resource.outstanding(), 0);
+}
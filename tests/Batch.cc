@@ -0,0 +1,163 @@
+#include <list>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+TEST(Batch, eventMajor)
+{
+  std::vector<std::pair<char, int>> calls;
+  sigs::Signal<void(int)> s;
+  s.connect([&calls](int i) { calls.emplace_back('a', i); });
+  s.connect([&calls](int i) { calls.emplace_back('b', i); });
+
+  const std::vector<std::tuple<int>> batch{{1}, {2}};
+  s.emitBatch(batch);
+  EXPECT_EQ(calls, (std::vector<std::pair<char, int>>{{'a', 1}, {'b', 1}, {'a', 2}, {'b', 2}}));
+}
+
+TEST(Batch, slotMajor)
+{
+  std::vector<std::pair<char, int>> calls;
+  sigs::Signal<void(int)> s;
+  s.connect([&calls](int i) { calls.emplace_back('a', i); });
+  s.connect([&calls](int i) { calls.emplace_back('b', i); });
+
+  const std::vector<std::tuple<int>> batch{{1}, {2}};
+  s.emitBatch(batch, sigs::BatchOrder::SlotMajor);
+  EXPECT_EQ(calls, (std::vector<std::pair<char, int>>{{'a', 1}, {'a', 2}, {'b', 1}, {'b', 2}}));
+}
+
+inline void addToSum(int &sum, int value)
+{
+  sum += value;
+}
+
+TEST(Batch, functionsAndReferences)
+{
+  sigs::SnapshotSignal<void(int &, int)> s;
+  s.connect(addToSum);
+
+  int sum = 0;
+  const std::vector<std::tuple<int &, int>> batch{{sum, 1}, {sum, 2}, {sum, 3}};
+  s.emitBatch(batch);
+  EXPECT_EQ(sum, 6);
+
+  s.emitBatch(batch, sigs::BatchOrder::SlotMajor);
+  EXPECT_EQ(sum, 12);
+}
+
+TEST(Batch, batchSlots)
+{
+  sigs::Signal<void(int)> s;
+
+  std::vector<std::size_t> sizes;
+  int sum = 0;
+  s.connectBatch([&](sigs::Signal<void(int)>::Batch batch) {
+    sizes.push_back(batch.size());
+    for (const auto &[value] : batch) {
+      sum += value;
+    }
+  });
+
+  const std::vector<std::tuple<int>> batch{{1}, {2}, {3}};
+  s.emitBatch(batch);
+  s.emitBatch(batch, sigs::BatchOrder::SlotMajor);
+  EXPECT_EQ(sizes, (std::vector<std::size_t>{3, 3}));
+  EXPECT_EQ(sum, 12);
+
+  // Regular emissions pass a batch of one.
+  s(4);
+  EXPECT_EQ(sizes, (std::vector<std::size_t>{3, 3, 1}));
+  EXPECT_EQ(sum, 16);
+}
+
+// Batch slots are invoked in connection order with regular slots, after the slots connected before
+// them received all events.
+TEST(Batch, batchSlotsInConnectionOrder)
+{
+  std::vector<std::pair<char, int>> calls;
+  sigs::Signal<void(int)> s;
+  s.connect([&calls](int i) { calls.emplace_back('a', i); });
+  s.connectBatch([&calls](sigs::Signal<void(int)>::Batch batch) {
+    calls.emplace_back('B', static_cast<int>(batch.size()));
+  });
+  s.connect([&calls](int i) { calls.emplace_back('c', i); });
+  s.connectBatch([&calls](sigs::Signal<void(int)>::Batch batch) {
+    calls.emplace_back('D', static_cast<int>(batch.size()));
+  });
+
+  const std::vector<std::tuple<int>> batch{{1}, {2}};
+  s.emitBatch(batch);
+  EXPECT_EQ(calls, (std::vector<std::pair<char, int>>{
+                     {'a', 1}, {'a', 2}, {'B', 2}, {'c', 1}, {'c', 2}, {'D', 2}}));
+
+  calls.clear();
+  s.emitBatch(batch, sigs::BatchOrder::SlotMajor);
+  EXPECT_EQ(calls, (std::vector<std::pair<char, int>>{
+                     {'a', 1}, {'a', 2}, {'B', 2}, {'c', 1}, {'c', 2}, {'D', 2}}));
+}
+
+TEST(Batch, iteratorPair)
+{
+  sigs::EpochSignal<void(int)> s;
+
+  int sum = 0;
+  std::size_t batchSize = 0;
+  s.connect([&sum](int i) { sum += i; });
+  s.connectBatch([&batchSize](sigs::EpochSignal<void(int)>::Batch batch) {
+    batchSize = batch.size();
+  });
+
+  // Not contiguous, so the batch slot gets a copy.
+  const std::list<std::tuple<int>> batch{{1}, {2}, {3}};
+  s.emitBatch(batch.begin(), batch.end());
+  EXPECT_EQ(sum, 6);
+  EXPECT_EQ(batchSize, 3);
+}
+
+TEST(Batch, connectedSignals)
+{
+  std::vector<std::pair<char, int>> calls;
+  sigs::Signal<void(int)> s, s2;
+  s.connect([&calls](int i) { calls.emplace_back('a', i); });
+  s.connect(s2);
+  s2.connect([&calls](int i) { calls.emplace_back('b', i); });
+
+  const std::vector<std::tuple<int>> batch{{1}, {2}};
+  s.emitBatch(batch);
+  EXPECT_EQ(calls, (std::vector<std::pair<char, int>>{{'a', 1}, {'b', 1}, {'a', 2}, {'b', 2}}));
+
+  calls.clear();
+  s.emitBatch(batch, sigs::BatchOrder::SlotMajor);
+  EXPECT_EQ(calls, (std::vector<std::pair<char, int>>{{'a', 1}, {'a', 2}, {'b', 1}, {'b', 2}}));
+}
+
+TEST(Batch, blocked)
+{
+  int calls = 0;
+  sigs::Signal<void(int)> s;
+  s.connect([&calls](int /*unused*/) { calls++; });
+  s.setBlocked(true);
+
+  const std::vector<std::tuple<int>> batch{{1}, {2}};
+  s.emitBatch(batch);
+  EXPECT_EQ(calls, 0);
+}
+
+TEST(Batch, disconnectBatchSlot)
+{
+  int calls = 0;
+  sigs::Signal<void(int)> s;
+  auto conn = s.connectBatch([&calls](sigs::Signal<void(int)>::Batch /*unused*/) { calls++; });
+  conn->disconnect();
+
+  const std::vector<std::tuple<int>> batch{{1}, {2}};
+  s.emitBatch(batch);
+  s(3);
+  EXPECT_EQ(calls, 0);
+  EXPECT_TRUE(s.empty());
+}
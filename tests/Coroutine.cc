@@ -0,0 +1,429 @@
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Coroutine that starts eagerly and destroys itself when done.
+class Task final {
+public:
+  class promise_type final {
+  public:
+    Task get_return_object() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never initial_suspend() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never final_suspend() noexcept
+    {
+      return {};
+    }
+
+    void return_void() noexcept
+    {
+    }
+
+    void unhandled_exception() noexcept
+    {
+    }
+  };
+};
+
+/// Coroutine that starts eagerly and is destroyed with the task, even while suspended.
+class OwningTask final {
+public:
+  class promise_type final {
+  public:
+    OwningTask get_return_object() noexcept
+    {
+      return OwningTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_never initial_suspend() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_always final_suspend() noexcept
+    {
+      return {};
+    }
+
+    void return_void() noexcept
+    {
+    }
+
+    void unhandled_exception() noexcept
+    {
+    }
+  };
+
+  explicit OwningTask(std::coroutine_handle<promise_type> handle_) noexcept : handle(handle_)
+  {
+  }
+
+  ~OwningTask()
+  {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  OwningTask(OwningTask &&rhs) noexcept : handle(std::exchange(rhs.handle, nullptr))
+  {
+  }
+
+  OwningTask &operator=(OwningTask &&) = delete;
+
+private:
+  std::coroutine_handle<promise_type> handle;
+};
+
+} // namespace
+
+TEST(Coroutine, next)
+{
+  sigs::Signal<void(int, const std::string &)> s;
+  s(0, "missed");
+
+  std::vector<std::string> received;
+  auto wait = [&]() -> Task {
+    auto [i, str] = *co_await s.next();
+    received.push_back(std::to_string(i) + str);
+    auto [i2, str2] = *co_await s.next();
+    received.push_back(std::to_string(i2) + str2);
+  };
+  wait();
+  EXPECT_TRUE(received.empty());
+
+  s(1, "a");
+  EXPECT_EQ(received, (std::vector<std::string>{"1a"}));
+
+  s(2, "b");
+  s(3, "c");
+  EXPECT_EQ(received, (std::vector<std::string>{"1a", "2b"}));
+}
+
+TEST(Coroutine, nextMultipleWaiters)
+{
+  sigs::Signal<void(int)> s;
+  s.connect([](int /*unused*/) {});
+
+  int sum = 0;
+  auto wait = [&]() -> Task {
+    auto [i] = *co_await s.next();
+    sum += i;
+  };
+  wait();
+  wait();
+  wait();
+
+  s(2);
+  EXPECT_EQ(sum, 6);
+}
+
+TEST(Coroutine, nextResumesInOrder)
+{
+  sigs::Signal<void()> s;
+
+  std::vector<int> resumed;
+  auto wait = [&](int id) -> Task {
+    co_await s.next();
+    resumed.push_back(id);
+  };
+  wait(1);
+  wait(2);
+  wait(3);
+
+  s();
+  EXPECT_EQ(resumed, (std::vector<int>{1, 2, 3}));
+}
+
+// The coroutine is resumed after the lock of a locked signal was released, so it may connect.
+TEST(Coroutine, nextConnectFromCoroutine)
+{
+  sigs::Signal<void()> s;
+
+  auto wait = [&]() -> Task {
+    co_await s.next();
+    s.connect([] {});
+  };
+  wait();
+
+  s();
+  EXPECT_EQ(s.size(), 1);
+}
+
+TEST(Coroutine, nextBlocked)
+{
+  sigs::Signal<void()> s;
+
+  bool resumed = false;
+  auto wait = [&]() -> Task {
+    co_await s.next();
+    resumed = true;
+  };
+  wait();
+
+  s.setBlocked(true);
+  s();
+  EXPECT_FALSE(resumed);
+
+  s.setBlocked(false);
+  s();
+  EXPECT_TRUE(resumed);
+}
+
+TEST(Coroutine, nextConnectedSignal)
+{
+  sigs::SnapshotSignal<void(int)> s, s2;
+  s.connect(s2);
+
+  int value = 0;
+  auto wait = [&]() -> Task {
+    auto [i] = *co_await s2.next();
+    value = i;
+  };
+  wait();
+
+  s(42);
+  EXPECT_EQ(value, 42);
+}
+
+TEST(Coroutine, nextDestroyedWhileWaiting)
+{
+  sigs::Signal<void(int)> s;
+
+  int resumed = 0;
+  auto wait = [&]() -> OwningTask {
+    co_await s.next();
+    resumed++;
+  };
+  auto task = std::make_unique<OwningTask>(wait());
+  auto task2 = std::make_unique<OwningTask>(wait());
+  task.reset();
+
+  s(1);
+  EXPECT_EQ(resumed, 1);
+}
+
+TEST(Coroutine, nextDestroyedDuringEmission)
+{
+  sigs::Signal<void(int)> s;
+
+  int resumed = 0;
+  auto wait = [&]() -> OwningTask {
+    co_await s.next();
+    resumed++;
+  };
+  auto task = std::make_unique<OwningTask>(wait());
+
+  // The emission has already taken the waiter when the slot destroys the coroutine.
+  s.connect([&task](int /*unused*/) { task.reset(); });
+  s(1);
+  EXPECT_EQ(resumed, 0);
+}
+
+TEST(Coroutine, nextSignalDestroyed)
+{
+  auto s = std::make_unique<sigs::Signal<void(int)>>();
+
+  std::vector<bool> received;
+  auto wait = [&]() -> Task {
+    const auto values = co_await s->next();
+    received.push_back(values.has_value());
+  };
+  wait();
+  wait();
+
+  s.reset();
+  EXPECT_EQ(received, (std::vector<bool>{false, false}));
+}
+
+TEST(Coroutine, nextOnExecutor)
+{
+  sigs::ThreadPool pool(1);
+  sigs::Signal<void(int)> s;
+
+  std::atomic_int value = 0;
+  std::atomic<std::thread::id> thread;
+  auto wait = [&]() -> Task {
+    auto [i] = *co_await s.next(pool);
+    thread = std::this_thread::get_id();
+    value = i;
+  };
+  wait();
+
+  s(42);
+  const auto deadline = std::chrono::steady_clock::now() + 10s;
+  while (value == 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(value, 42);
+  EXPECT_NE(thread.load(), std::this_thread::get_id());
+}
+
+TEST(Coroutine, nextParallel)
+{
+  sigs::ThreadPool pool(1);
+  sigs::Signal<int(int)> s;
+  s.connect([](int i) { return i; });
+
+  std::vector<int> received;
+  auto wait = [&]() -> Task {
+    auto [i] = *co_await s.next();
+    received.push_back(i);
+    auto [i2] = *co_await s.next();
+    received.push_back(i2);
+  };
+  wait();
+
+  s.emitParallel(pool, 1);
+  EXPECT_EQ(received, (std::vector<int>{1}));
+
+  int sum = 0;
+  s.emitParallel(pool, [&sum](int value) { sum += value; }, 2);
+  EXPECT_EQ(sum, 2);
+  EXPECT_EQ(received, (std::vector<int>{1, 2}));
+}
+
+TEST(Coroutine, stream)
+{
+  sigs::Signal<void(int)> s;
+
+  std::vector<int> received;
+  {
+    auto stream = s.stream();
+    EXPECT_EQ(s.size(), 1);
+
+    // Emissions are buffered until read.
+    s(1);
+    s(2);
+    EXPECT_EQ(stream.size(), 2);
+
+    auto read = [&]() -> Task {
+      for (int n = 0; n < 4; ++n) {
+        auto [i] = *co_await stream.next();
+        received.push_back(i);
+      }
+    };
+    read();
+    EXPECT_EQ(received, (std::vector<int>{1, 2}));
+    EXPECT_EQ(stream.size(), 0);
+
+    s(3);
+    s(4);
+    s(5);
+    EXPECT_EQ(received, (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_EQ(stream.size(), 1);
+  }
+
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Coroutine, streamMoveAssignment)
+{
+  sigs::Signal<void(int)> s;
+  auto stream = s.stream();
+  auto stream2 = s.stream();
+  EXPECT_EQ(s.size(), 2);
+
+  // The overwritten stream is disconnected.
+  stream = std::move(stream2);
+  EXPECT_EQ(s.size(), 1);
+
+  s(1);
+  EXPECT_EQ(stream.size(), 1);
+}
+
+TEST(Coroutine, streamDestroyedWhileWaiting)
+{
+  sigs::Signal<void(int)> s;
+  auto stream = s.stream();
+
+  int resumed = 0;
+  auto read = [&]() -> OwningTask {
+    co_await stream.next();
+    resumed++;
+  };
+  auto task = std::make_unique<OwningTask>(read());
+  task.reset();
+
+  // The emission is buffered instead of resuming the destroyed coroutine.
+  s(1);
+  EXPECT_EQ(resumed, 0);
+  EXPECT_EQ(stream.size(), 1);
+}
+
+TEST(Coroutine, streamSignalDestroyed)
+{
+  auto s = std::make_unique<sigs::Signal<void(int)>>();
+  auto stream = s->stream();
+  (*s)(1);
+
+  std::vector<int> received;
+  bool closed = false;
+  auto read = [&]() -> Task {
+    while (const auto values = co_await stream.next()) {
+      received.push_back(std::get<0>(*values));
+    }
+    closed = true;
+  };
+  read();
+  EXPECT_EQ(received, (std::vector<int>{1}));
+  EXPECT_FALSE(closed);
+
+  s.reset();
+  EXPECT_TRUE(closed);
+
+  // Reading after the signal is gone finishes right away.
+  closed = false;
+  read();
+  EXPECT_TRUE(closed);
+}
+
+TEST(Coroutine, streamFromThreads)
+{
+  sigs::SnapshotSignal<void(int)> s;
+  auto stream = s.stream();
+
+  std::atomic_int sum = 0;
+  std::atomic_int count = 0;
+  auto read = [&]() -> Task {
+    for (;;) {
+      auto [i] = *co_await stream.next();
+      sum += i;
+      if (++count == 2000) break;
+    }
+  };
+  read();
+
+  auto emit = [&] {
+    for (int n = 0; n < 1000; ++n) {
+      s(1);
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+  t1.join();
+  t2.join();
+
+  EXPECT_EQ(sum, 2000);
+}
@@ -0,0 +1,145 @@
+#include <array>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+inline int twice(int i)
+{
+  return i * 2;
+}
+
+TEST(Delegate, empty)
+{
+  sigs::Delegate<void()> d;
+  EXPECT_FALSE(d);
+
+  sigs::Delegate<void()> d2(nullptr);
+  EXPECT_FALSE(d2);
+}
+
+TEST(Delegate, function)
+{
+  sigs::Delegate<int(int)> d(twice);
+  ASSERT_TRUE(d);
+  EXPECT_FALSE(d.allocated());
+  EXPECT_EQ(d(21), 42);
+}
+
+TEST(Delegate, smallLambdaInline)
+{
+  int calls = 0;
+  sigs::Delegate<void()> d([&calls] { calls++; });
+  EXPECT_FALSE(d.allocated());
+
+  d();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(Delegate, largeLambdaAllocated)
+{
+  std::array<char, 64> data{};
+  data[0] = 'x';
+  sigs::Delegate<char()> d([data] { return data[0]; });
+  EXPECT_TRUE(d.allocated());
+  EXPECT_EQ(d(), 'x');
+}
+
+TEST(Delegate, customCapacity)
+{
+  std::array<char, 64> data{};
+  data[0] = 'x';
+  sigs::Delegate<char(), 64> d([data] { return data[0]; });
+  EXPECT_FALSE(d.allocated());
+  EXPECT_EQ(d(), 'x');
+}
+
+TEST(Delegate, nonTriviallyCopyableAllocated)
+{
+  auto ptr = std::make_shared<int>(1);
+  sigs::Delegate<int()> d([ptr] { return *ptr; });
+  EXPECT_TRUE(d.allocated());
+  EXPECT_EQ(ptr.use_count(), 2);
+
+  {
+    auto copy = d;
+    EXPECT_EQ(ptr.use_count(), 3);
+    EXPECT_EQ(copy(), 1);
+  }
+  EXPECT_EQ(ptr.use_count(), 2);
+
+  auto moved = std::move(d);
+  EXPECT_FALSE(d);
+  EXPECT_EQ(ptr.use_count(), 2);
+  EXPECT_EQ(moved(), 1);
+
+  moved = nullptr;
+  EXPECT_FALSE(moved);
+  EXPECT_EQ(ptr.use_count(), 1);
+}
+
+TEST(Delegate, copyAssign)
+{
+  sigs::Delegate<int()> d([] { return 1; });
+  sigs::Delegate<int()> d2([s = std::string("two")] { return static_cast<int>(s.size()); });
+
+  d = d2;
+  EXPECT_EQ(d(), 3);
+  EXPECT_EQ(d2(), 3);
+
+  d2 = [] { return 2; };
+  EXPECT_EQ(d(), 3);
+  EXPECT_EQ(d2(), 2);
+}
+
+TEST(Delegate, mutableState)
+{
+  sigs::Delegate<int()> d([n = 0]() mutable { return ++n; });
+  EXPECT_EQ(d(), 1);
+  EXPECT_EQ(d(), 2);
+}
+
+TEST(Delegate, ignoresReturnValue)
+{
+  int calls = 0;
+  sigs::Delegate<void()> d([&calls] { return ++calls; });
+  d();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(Delegate, dontMoveRvalues)
+{
+  std::string res;
+  sigs::Delegate<void(std::string)> d([&res](std::string str) { res += str; });
+
+  const std::string str = "test";
+  d(str);
+  d(str);
+  EXPECT_EQ(res, "testtest");
+}
+
+TEST(Delegate, bindMemberFunction)
+{
+  class Foo {
+  public:
+    int add(int i)
+    {
+      value += i;
+      return value;
+    }
+
+    int value = 0;
+  };
+
+  Foo foo;
+  auto d = sigs::Delegate<int(int)>::bind(&foo, &Foo::add);
+  EXPECT_FALSE(d.allocated());
+  EXPECT_EQ(d(2), 2);
+
+  auto d2 = sigs::Delegate<int(int)>::bind<&Foo::add>(&foo);
+  EXPECT_FALSE(d2.allocated());
+  EXPECT_EQ(d2(3), 5);
+  EXPECT_EQ(foo.value, 5);
+}
@@ -0,0 +1,1207 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+using namespace std::chrono_literals;
+
+TEST(Emission, lockedDisconnectFromSlot)
+{
+  sigs::Signal<void()> s;
+
+  int calls = 0;
+  sigs::Connection conn1, conn2;
+  conn1 = s.connect([&] {
+    calls++;
+    conn1->disconnect();
+    conn2->disconnect();
+
+    // Erased once the emission exits.
+    EXPECT_EQ(s.size(), 2);
+  });
+  conn2 = s.connect([&] { calls += 10; });
+
+  // The second slot must not be invoked after being disconnected by the first one.
+  s();
+  s();
+  EXPECT_EQ(calls, 1);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Emission, lockedConnectFromSlot)
+{
+  sigs::Signal<void()> s;
+
+  int calls = 0;
+  sigs::Connection conn;
+  conn = s.connect([&] {
+    s.connect([&] { calls++; });
+
+    // Disconnecting a slot connected during the same emission.
+    auto added = s.connect([&] { calls += 10; });
+    added->disconnect();
+    conn->disconnect();
+  });
+
+  // The slots connected during the emission are only added once it exits.
+  s();
+  EXPECT_EQ(calls, 0);
+  EXPECT_EQ(s.size(), 1);
+
+  s();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(Emission, lockedConnectAllFromSlot)
+{
+  sigs::Signal<void()> s;
+
+  int calls = 0;
+  sigs::Connection conn;
+  conn = s.connect([&] {
+    std::vector<std::function<void()>> funcs{[&] { calls++; }, [&] { calls += 10; }};
+    auto conns = s.connectAll(funcs);
+    conns[1]->disconnect();
+    conn->disconnect();
+  });
+
+  s();
+  EXPECT_EQ(calls, 0);
+  EXPECT_EQ(s.size(), 1);
+
+  s();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(Emission, lockedClearFromSlot)
+{
+  sigs::Signal<void()> s, s2;
+
+  int calls = 0;
+  s.connect([&] {
+    calls++;
+    s.clear();
+    s.connect([&] { calls += 10; });
+  });
+  s.connect([&] { calls += 100; });
+  s.connect(s2);
+  s2.connect([&] { calls += 1000; });
+
+  s();
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(s.size(), 1);
+
+  s();
+  EXPECT_EQ(calls, 11);
+}
+
+TEST(Emission, lockedNestedEmission)
+{
+  sigs::Signal<void(int)> s;
+
+  std::vector<int> values;
+  sigs::Connection conn;
+  s.connect([&](int depth) {
+    values.push_back(depth);
+    if (depth == 0) {
+      s(1);
+      EXPECT_EQ(s.size(), 2);
+    }
+    else {
+      conn->disconnect();
+    }
+  });
+  conn = s.connect([&](int depth) { values.push_back(depth + 10); });
+
+  // The nested emission disconnects the second slot, which the outer one skips then.
+  s(0);
+  EXPECT_EQ(values, (std::vector<int>{0, 1}));
+  EXPECT_EQ(s.size(), 1);
+}
+
+TEST(Emission, lockedNestedClear)
+{
+  sigs::Signal<void(int)> s;
+
+  std::vector<int> values;
+  s.connect([&](int depth) {
+    values.push_back(depth);
+    if (depth < 2) {
+      s(depth + 1);
+      s.clear();
+    }
+  });
+
+  // Each emission clears the slot, which is only erased once.
+  s(0);
+  EXPECT_EQ(values, (std::vector<int>{0, 1, 2}));
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Emission, lockedChainedDisconnectFromSlot)
+{
+  sigs::Signal<void()> s, s2;
+
+  int calls = 0;
+  s.connect(s2);
+  s2.connect([&] {
+    calls++;
+    s.disconnect(s2);
+  });
+  s.connect(s2);
+
+  // Both connections of s2 are disconnected by the first emission of it.
+  s();
+  s();
+  EXPECT_EQ(calls, 1);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Emission, lockedConcurrentModification)
+{
+  sigs::Signal<void(int &)> s;
+  s.connect([](int &i) { i++; });
+  s.connect([&s](int & /*unused*/) {
+    auto conn = s.connect([](int &i) { i += 10; });
+    conn->disconnect();
+  });
+
+  std::atomic_bool done = false;
+  std::thread writer([&] {
+    for (int n = 0; n < 1000; ++n) {
+      auto conn = s.connect([](int & /*unused*/) {});
+      conn->disconnect();
+    }
+    done = true;
+  });
+
+  auto emit = [&] {
+    while (!done) {
+      int i = 0;
+      s(i);
+      ASSERT_EQ(i, 1);
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+  writer.join();
+  t1.join();
+  t2.join();
+  EXPECT_EQ(s.size(), 2);
+}
+
+TEST(Emission, sharedConcurrentEmissions)
+{
+  sigs::SharedSignal<void()> s;
+
+  std::atomic_int inside = 0;
+  std::atomic_int overlapped = 0;
+  s.connect([&] {
+    inside++;
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (inside < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    if (inside == 2) {
+      overlapped++;
+    }
+
+    // Reading while the other thread is emitting too.
+    EXPECT_EQ(s.size(), 1);
+  });
+
+  std::thread t1([&s] { s(); });
+  std::thread t2([&s] { s(); });
+  t1.join();
+  t2.join();
+
+  ASSERT_EQ(overlapped, 2);
+}
+
+TEST(Emission, sharedDisconnectFromSlot)
+{
+  sigs::SharedSignal<void()> s;
+
+  int calls = 0;
+  sigs::Connection conn1, conn2;
+  conn1 = s.connect([&] {
+    calls++;
+    conn1->disconnect();
+    conn2->disconnect();
+    s.connect([&] { calls += 100; });
+  });
+  conn2 = s.connect([&] { calls += 10; });
+
+  // The second slot must not be invoked after being disconnected by the first one.
+  s();
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(s.size(), 1);
+
+  s();
+  EXPECT_EQ(calls, 101);
+}
+
+TEST(Emission, sharedConcurrentModification)
+{
+  sigs::SharedSignal<void(int &)> s;
+  s.connect([](int &i) { i++; });
+  s.connect([&s](int & /*unused*/) {
+    auto conn = s.connect([](int &i) { i += 10; });
+    conn->disconnect();
+  });
+
+  std::atomic_bool done = false;
+  std::thread writer([&] {
+    for (int n = 0; n < 1000; ++n) {
+      auto conn = s.connect([](int & /*unused*/) {});
+      conn->disconnect();
+    }
+    done = true;
+  });
+
+  auto emit = [&] {
+    while (!done) {
+      int i = 0;
+      s(i);
+      ASSERT_EQ(i, 1);
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+  writer.join();
+  t1.join();
+  t2.join();
+  EXPECT_EQ(s.size(), 2);
+}
+
+// A connection made from a slot is only added once the emission has released its shared lock and
+// taken an exclusive one, and disconnecting it from another thread meanwhile must not be lost.
+TEST(Emission, sharedDisconnectDeferredConnection)
+{
+  for (int n = 0; n < 100; ++n) {
+    sigs::SharedSignal<void()> s;
+    std::mutex mutex;
+    sigs::Connection added;
+    std::atomic_bool connected = false, disconnecting = false;
+    s.connect([&] {
+      if (connected) return;
+
+      {
+        std::scoped_lock lock(mutex);
+        added = s.connect([] {});
+        connected = true;
+      }
+
+      // Lets the other thread wait for the exclusive lock, which it does right after raising the
+      // flag, since the emission holds the lock shared until returning.
+      while (!disconnecting) {
+        std::this_thread::yield();
+      }
+    });
+
+    std::thread other([&] {
+      while (!connected) {
+        std::this_thread::yield();
+      }
+      std::scoped_lock lock(mutex);
+      disconnecting = true;
+      added->disconnect();
+    });
+    s();
+    other.join();
+    ASSERT_EQ(s.size(), 1);
+  }
+}
+
+TEST(Emission, snapshotSlots)
+{
+  sigs::SnapshotSignal<void(int &)> s;
+  s.connect([](int &i) { i++; });
+  auto conn = s.connect([](int &i) { i += 2; });
+
+  int i = 0;
+  s(i);
+  EXPECT_EQ(i, 3);
+
+  conn->disconnect();
+  s(i);
+  EXPECT_EQ(i, 4);
+  EXPECT_EQ(s.size(), 1);
+
+  s.clear();
+  s(i);
+  EXPECT_EQ(i, 4);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Emission, snapshotReturnValuesWithSignals)
+{
+  sigs::SnapshotSignal<int()> s, s2;
+  s2.connect([] { return 1; });
+  s.connect(s2);
+  s.connect([] { return 2; });
+
+  int sum = 0;
+  s([&sum](int retVal) { sum += retVal; });
+  EXPECT_EQ(sum, 1 + 2);
+}
+
+TEST(Emission, snapshotDisconnectFromSlot)
+{
+  sigs::SnapshotSignal<void()> s;
+
+  int calls = 0;
+  sigs::Connection conn;
+  conn = s.connect([&] {
+    calls++;
+    conn->disconnect();
+  });
+
+  s();
+  s();
+  EXPECT_EQ(calls, 1);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Emission, snapshotConnectFromSlot)
+{
+  sigs::SnapshotSignal<void()> s;
+
+  int calls = 0;
+  s.connect([&] { s.connect([&] { calls++; }); });
+
+  // The slot connected during the emission is not part of its snapshot.
+  s();
+  EXPECT_EQ(calls, 0);
+  EXPECT_EQ(s.size(), 2);
+
+  s();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(Emission, snapshotChainedSignals)
+{
+  sigs::SnapshotSignal<void(std::vector<int> &)> s, s2, s3;
+  s.connect([](std::vector<int> &v) { v.push_back(1); });
+  s.connect(s2);
+  s.connect([](std::vector<int> &v) { v.push_back(4); });
+  s2.connect([](std::vector<int> &v) { v.push_back(2); });
+  s2.connect(s3);
+  s3.connect([](std::vector<int> &v) { v.push_back(3); });
+
+  std::vector<int> v;
+  s(v);
+  EXPECT_EQ(v, (std::vector<int>{1, 2, 3, 4}));
+
+  // Modifying any signal of the chain must be picked up by the next emission.
+  auto conn = s3.connect([](std::vector<int> &order) { order.push_back(5); });
+  v.clear();
+  s(v);
+  EXPECT_EQ(v, (std::vector<int>{1, 2, 3, 5, 4}));
+
+  conn->disconnect();
+  s2.setBlocked(true);
+  v.clear();
+  s(v);
+  EXPECT_EQ(v, (std::vector<int>{1, 4}));
+
+  s2.setBlocked(false);
+  s.disconnect(s2);
+  v.clear();
+  s(v);
+  EXPECT_EQ(v, (std::vector<int>{1, 4}));
+}
+
+TEST(Emission, snapshotShortCircuitChainedSignals)
+{
+  std::vector<int> calls;
+  sigs::SnapshotSignal<int *()> s, s2;
+  int value = 0;
+  s.connect([&calls]() -> int * {
+    calls.push_back(1);
+    return nullptr;
+  });
+  s.connect(s2);
+  s.connect([&calls, &value] {
+    calls.push_back(4);
+    return &value;
+  });
+  s2.connect([&calls]() -> int * {
+    calls.push_back(2);
+    return nullptr;
+  });
+  s2.connect([&calls, &value] {
+    calls.push_back(3);
+    return &value;
+  });
+
+  EXPECT_EQ(s.emit<sigs::collect::FirstNonNull>(), &value);
+  EXPECT_EQ(calls, (std::vector<int>{1, 2, 3}));
+
+  s2.setBlocked(true);
+  calls.clear();
+  EXPECT_EQ(s.emit<sigs::collect::FirstNonNull>(), &value);
+  EXPECT_EQ(calls, (std::vector<int>{1, 4}));
+}
+
+// A connection closing a cycle is rejected.
+TEST(Emission, snapshotChainedSignalsCycle)
+{
+  sigs::SnapshotSignal<void()> s, s2;
+  s.connect(s2);
+  EXPECT_FALSE(s2.connect(s));
+  EXPECT_EQ(s2.size(), 0);
+
+  int calls = 0;
+  s2.connect([&calls] { calls++; });
+  s();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(Emission, snapshotCopy)
+{
+  sigs::SnapshotSignal<void()> s;
+  s.connect([] {});
+
+  decltype(s) s2(s);
+  s2.connect([] {});
+  EXPECT_EQ(s.size(), 1);
+  EXPECT_EQ(s2.size(), 2);
+
+  s.clear();
+  EXPECT_EQ(s.size(), 0);
+  EXPECT_EQ(s2.size(), 2);
+}
+
+// Both emissions must be inside the slot at the same time, which is impossible if emitting holds
+// the entries lock.
+TEST(Emission, snapshotConcurrentEmissions)
+{
+  sigs::SnapshotSignal<void()> s;
+
+  std::atomic_int inside = 0;
+  std::atomic_int overlapped = 0;
+  s.connect([&] {
+    inside++;
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (inside < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    if (inside == 2) {
+      overlapped++;
+    }
+  });
+
+  std::thread t1([&s] { s(); });
+  std::thread t2([&s] { s(); });
+  t1.join();
+  t2.join();
+
+  ASSERT_EQ(overlapped, 2);
+}
+
+TEST(Emission, snapshotConcurrentModification)
+{
+  sigs::SnapshotSignal<void(int &)> s;
+  s.connect([](int &i) { i++; });
+
+  std::atomic_bool done = false;
+  std::thread writer([&] {
+    for (int n = 0; n < 1000; ++n) {
+      auto conn = s.connect([](int & /*unused*/) {});
+      conn->disconnect();
+    }
+    done = true;
+  });
+
+  auto emit = [&] {
+    while (!done) {
+      int i = 0;
+      s(i);
+      ASSERT_EQ(i, 1);
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+  writer.join();
+  t1.join();
+  t2.join();
+}
+
+TEST(Emission, epochSlots)
+{
+  sigs::EpochSignal<void(int &)> s;
+  s.connect([](int &i) { i++; });
+  auto conn = s.connect([](int &i) { i += 2; });
+
+  int i = 0;
+  s(i);
+  EXPECT_EQ(i, 3);
+
+  conn->disconnect();
+  s(i);
+  EXPECT_EQ(i, 4);
+  EXPECT_EQ(s.size(), 1);
+
+  s.clear();
+  s(i);
+  EXPECT_EQ(i, 4);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Emission, epochReturnValuesWithSignals)
+{
+  sigs::EpochSignal<int()> s, s2;
+  s2.connect([] { return 1; });
+  s.connect(s2);
+  s.connect([] { return 2; });
+
+  int sum = 0;
+  s([&sum](int retVal) { sum += retVal; });
+  EXPECT_EQ(sum, 1 + 2);
+}
+
+TEST(Emission, epochDisconnectFromSlot)
+{
+  sigs::EpochSignal<void()> s;
+
+  int calls = 0;
+  sigs::Connection conn1, conn2;
+  conn1 = s.connect([&] {
+    calls++;
+    conn1->disconnect();
+    conn2->disconnect();
+  });
+  conn2 = s.connect([&] { calls += 10; });
+
+  // The second slot must not be invoked after being disconnected by the first one.
+  s();
+  s();
+  EXPECT_EQ(calls, 1);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Emission, epochConnectAll)
+{
+  sigs::EpochSignal<void(int &)> s;
+  s.connect([](int &i) { i++; });
+
+  auto slot = [](int &i) { i++; };
+  const std::vector<decltype(slot)> slots(100, slot);
+  auto conns = s.connectAll(slots);
+  EXPECT_EQ(s.size(), 101);
+
+  for (std::size_t n = 0; n < std::size(conns); n += 2) {
+    conns[n]->disconnect();
+  }
+
+  int i = 0;
+  s(i);
+  EXPECT_EQ(i, 51);
+}
+
+TEST(Emission, epochChainedSignals)
+{
+  sigs::EpochSignal<void(std::vector<int> &)> s, s2, s3;
+  s.connect([](std::vector<int> &v) { v.push_back(1); });
+  s.connect(s2);
+  s.connect([](std::vector<int> &v) { v.push_back(4); });
+  s2.connect([](std::vector<int> &v) { v.push_back(2); });
+  s2.connect(s3);
+  s3.connect([](std::vector<int> &v) { v.push_back(3); });
+
+  std::vector<int> v;
+  s(v);
+  EXPECT_EQ(v, (std::vector<int>{1, 2, 3, 4}));
+
+  // Modifying any signal of the chain must be picked up by the next emission.
+  auto conn = s3.connect([](std::vector<int> &order) { order.push_back(5); });
+  v.clear();
+  s(v);
+  EXPECT_EQ(v, (std::vector<int>{1, 2, 3, 5, 4}));
+
+  conn->disconnect();
+  s2.setBlocked(true);
+  v.clear();
+  s(v);
+  EXPECT_EQ(v, (std::vector<int>{1, 4}));
+
+  s2.setBlocked(false);
+  s.disconnect(s2);
+  v.clear();
+  s(v);
+  EXPECT_EQ(v, (std::vector<int>{1, 4}));
+}
+
+TEST(Emission, epochShortCircuitChainedSignals)
+{
+  std::vector<int> calls;
+  sigs::EpochSignal<int *()> s, s2;
+  int value = 0;
+  s.connect([&calls]() -> int * {
+    calls.push_back(1);
+    return nullptr;
+  });
+  s.connect(s2);
+  s.connect([&calls, &value] {
+    calls.push_back(4);
+    return &value;
+  });
+  s2.connect([&calls]() -> int * {
+    calls.push_back(2);
+    return nullptr;
+  });
+  s2.connect([&calls, &value] {
+    calls.push_back(3);
+    return &value;
+  });
+
+  EXPECT_EQ(s.emit<sigs::collect::FirstNonNull>(), &value);
+  EXPECT_EQ(calls, (std::vector<int>{1, 2, 3}));
+
+  s2.setBlocked(true);
+  calls.clear();
+  EXPECT_EQ(s.emit<sigs::collect::FirstNonNull>(), &value);
+  EXPECT_EQ(calls, (std::vector<int>{1, 4}));
+}
+
+TEST(Emission, epochChainedDisconnectFromSlot)
+{
+  sigs::EpochSignal<void()> s, s2;
+  s.connect(s2);
+
+  int calls = 0;
+  sigs::Connection conn1, conn2;
+  conn1 = s2.connect([&] {
+    calls++;
+    conn2->disconnect();
+  });
+  conn2 = s2.connect([&] { calls += 10; });
+
+  // The slot of the connected signal must not be invoked after being disconnected by the first one.
+  s();
+  s();
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(Emission, epochChainedSignalsCycle)
+{
+  sigs::EpochSignal<void()> s, s2, s3;
+  s.connect(s2);
+  s2.connect(s3);
+  EXPECT_FALSE(s3.connect(s2));
+  EXPECT_FALSE(s3.connect(s));
+
+  // Reaching a signal twice without a cycle is fine.
+  EXPECT_TRUE(s.connect(s3));
+
+  int calls = 0;
+  s3.connect([&calls] { calls++; });
+  s();
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(Emission, epochConcurrentEmissions)
+{
+  sigs::EpochSignal<void()> s;
+
+  std::atomic_int inside = 0;
+  std::atomic_int overlapped = 0;
+  s.connect([&] {
+    inside++;
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (inside < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    if (inside == 2) {
+      overlapped++;
+    }
+  });
+
+  std::thread t1([&s] { s(); });
+  std::thread t2([&s] { s(); });
+  t1.join();
+  t2.join();
+
+  ASSERT_EQ(overlapped, 2);
+}
+
+// Once a disconnect returns, no emission of another thread may invoke the slot anymore.
+TEST(Emission, epochDisconnectWaitsForEmissions)
+{
+  sigs::EpochSignal<void()> s;
+
+  std::atomic_bool disconnected = false;
+  std::atomic_bool violated = false;
+  std::atomic_bool done = false;
+
+  auto emit = [&] {
+    while (!done) {
+      s();
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+
+  for (int n = 0; n < 10; ++n) {
+    disconnected = false;
+    std::atomic_bool entered = false;
+    auto conn = s.connect([&] {
+      entered = true;
+      for (int i = 0; i < 50 && !disconnected; ++i) {
+        std::this_thread::yield();
+      }
+      if (disconnected) {
+        violated = true;
+      }
+    });
+
+    // Disconnects while the slot is running.
+    while (!entered) {
+      std::this_thread::yield();
+    }
+    conn->disconnect();
+    disconnected = true;
+  }
+
+  done = true;
+  t1.join();
+  t2.join();
+
+  ASSERT_FALSE(violated);
+}
+
+// Same for a slot invoked through the dispatch plan of a signal connected to it.
+TEST(Emission, epochDisconnectWaitsForConnectedEmissions)
+{
+  sigs::EpochSignal<void()> s1;
+  sigs::EpochSignal<void()> s2;
+  s1.connect(s2);
+
+  std::atomic_bool disconnected = false;
+  std::atomic_bool violated = false;
+  std::atomic_bool done = false;
+
+  auto emit = [&] {
+    while (!done) {
+      s1();
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+
+  for (int n = 0; n < 10; ++n) {
+    disconnected = false;
+    std::atomic_bool entered = false;
+    auto conn = s2.connect([&] {
+      entered = true;
+      for (int i = 0; i < 50 && !disconnected; ++i) {
+        std::this_thread::yield();
+      }
+      if (disconnected) {
+        violated = true;
+      }
+    });
+
+    // Disconnects while the slot is running.
+    while (!entered) {
+      std::this_thread::yield();
+    }
+    conn->disconnect();
+    disconnected = true;
+  }
+
+  done = true;
+  t1.join();
+  t2.join();
+
+  ASSERT_FALSE(violated);
+}
+
+// Threads emitting the same signal whose slots disconnect from it don't wait for each other.
+TEST(Emission, epochDisconnectFromSlotsDoesNotWait)
+{
+  sigs::EpochSignal<void()> s;
+
+  std::latch inside(2);
+  std::atomic_int next = 0;
+  std::vector<sigs::Connection> conns;
+  s.connect([&] {
+    inside.arrive_and_wait();
+    conns[next++]->disconnect();
+  });
+  conns.push_back(s.connect([] {}));
+  conns.push_back(s.connect([] {}));
+
+  std::thread t1([&s] { s(); });
+  std::thread t2([&s] { s(); });
+  t1.join();
+  t2.join();
+  EXPECT_EQ(s.size(), 1);
+}
+
+// Modifying a signal never waits for emissions of other signals, whose slots might wait for the
+// modifying thread.
+TEST(Emission, epochModificationDoesNotWait)
+{
+  sigs::EpochSignal<void()> s1;
+  sigs::EpochSignal<void()> s2;
+
+  std::mutex mutex;
+  std::atomic_bool entered = false;
+  s1.connect([&] {
+    entered = true;
+    std::scoped_lock lock(mutex);
+  });
+
+  std::unique_lock lock(mutex);
+  std::thread emitter([&] { s1(); });
+  while (!entered) {
+    std::this_thread::yield();
+  }
+
+  auto conn = s2.connect([] {});
+  conn->disconnect();
+
+  lock.unlock();
+  emitter.join();
+}
+
+// Rebuilding the plan of a chained signal while emitting never waits for other emissions either.
+TEST(Emission, epochEmissionDoesNotWait)
+{
+  sigs::EpochSignal<void()> s1;
+  sigs::EpochSignal<void()> s2;
+  sigs::EpochSignal<void()> s3;
+  s2.connect(s3);
+  s2();
+
+  int count = 0;
+  s3.connect([&count] { count++; });
+
+  std::mutex mutex;
+  std::atomic_bool entered = false;
+  s1.connect([&] {
+    entered = true;
+    std::scoped_lock lock(mutex);
+  });
+
+  std::unique_lock lock(mutex);
+  std::thread emitter([&] { s1(); });
+  while (!entered) {
+    std::this_thread::yield();
+  }
+
+  // The plan built by the first emission is outdated and retired.
+  s2();
+  EXPECT_EQ(1, count);
+
+  lock.unlock();
+  emitter.join();
+}
+
+TEST(Emission, epochConcurrentModification)
+{
+  sigs::EpochSignal<void(int &)> s;
+  s.connect([](int &i) { i++; });
+
+  std::atomic_bool done = false;
+  std::thread writer([&] {
+    for (int n = 0; n < 1000; ++n) {
+      auto conn = s.connect([](int & /*unused*/) {});
+      conn->disconnect();
+    }
+    done = true;
+  });
+
+  auto emit = [&] {
+    while (!done) {
+      int i = 0;
+      s(i);
+      ASSERT_EQ(i, 1);
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+  writer.join();
+  t1.join();
+  t2.join();
+}
+
+TEST(Emission, snapshotChainedConcurrentModification)
+{
+  sigs::SnapshotSignal<void(int &)> s, s2;
+  s.connect(s2);
+  s2.connect([](int &i) { i++; });
+
+  std::atomic_bool done = false;
+  std::thread writer([&] {
+    for (int n = 0; n < 1000; ++n) {
+      auto conn = s2.connect([](int & /*unused*/) {});
+      conn->disconnect();
+    }
+    done = true;
+  });
+
+  auto emit = [&] {
+    while (!done) {
+      int i = 0;
+      s(i);
+      ASSERT_EQ(i, 1);
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+  writer.join();
+  t1.join();
+  t2.join();
+}
+
+TEST(Emission, epochChainedConcurrentModification)
+{
+  sigs::EpochSignal<void(int &)> s, s2;
+  s.connect(s2);
+  s2.connect([](int &i) { i++; });
+
+  std::atomic_bool done = false;
+  std::thread writer([&] {
+    for (int n = 0; n < 1000; ++n) {
+      auto conn = s2.connect([](int & /*unused*/) {});
+      conn->disconnect();
+    }
+    done = true;
+  });
+
+  auto emit = [&] {
+    while (!done) {
+      int i = 0;
+      s(i);
+      ASSERT_EQ(i, 1);
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+  writer.join();
+  t1.join();
+  t2.join();
+}
+
+TEST(Emission, parallel)
+{
+  sigs::ThreadPool pool(3);
+  sigs::Signal<void(std::atomic_int &)> s;
+  for (int n = 0; n < 100; ++n) {
+    s.connect([](std::atomic_int &i) { i++; });
+  }
+
+  std::atomic_int i = 0;
+  s.emitParallel(pool, i);
+  EXPECT_EQ(i, 100);
+
+  s.setBlocked(true);
+  s.emitParallel(pool, i);
+  EXPECT_EQ(i, 100);
+}
+
+TEST(Emission, parallelReturnValuesInOrder)
+{
+  sigs::ThreadPool pool(2, {0});
+  sigs::SnapshotSignal<int()> s, s2;
+  std::vector<int> expected;
+  for (int n = 0; n < 10; ++n) {
+    s.connect([n] { return n; });
+    expected.push_back(n);
+  }
+  s2.connect([] { return 10; });
+  s2.connect([] { return 11; });
+  s.connect(s2);
+  expected.insert(expected.end(), {10, 11});
+
+  std::vector<int> values;
+  s.emitParallel(pool, [&values](int value) { values.push_back(value); });
+  EXPECT_EQ(values, expected);
+}
+
+namespace {
+
+struct SingleSlotChunksPolicy : sigs::EpochPolicy {
+  static constexpr std::size_t parallelChunkSize = 1;
+};
+
+} // namespace
+
+TEST(Emission, parallelChunkSize)
+{
+  sigs::ThreadPool pool(2);
+  sigs::BasicSignal<void(std::atomic_int &), sigs::BasicLock, SingleSlotChunksPolicy> s;
+  std::mutex mutex;
+  std::vector<std::thread::id> threads;
+  for (int n = 0; n < 8; ++n) {
+    s.connect([&](std::atomic_int &i) {
+      i++;
+      std::scoped_lock lock(mutex);
+      threads.push_back(std::this_thread::get_id());
+    });
+  }
+
+  std::atomic_int i = 0;
+  s.emitParallel(pool, i);
+  EXPECT_EQ(i, 8);
+  EXPECT_EQ(threads.size(), 8);
+
+  sigs::BasicSignal<void(std::atomic_int &), sigs::BasicLock, SingleSlotChunksPolicy> empty;
+  empty.emitParallel(pool, i);
+  EXPECT_EQ(i, 8);
+}
+
+namespace {
+
+/// Runs each task right away on the emitting thread, before the chunk the emitting thread runs.
+class InlineExecutor final {
+public:
+  void execute(std::function<void()> task) noexcept
+  {
+    task();
+  }
+
+  [[nodiscard]] std::size_t concurrency() const noexcept
+  {
+    return 1;
+  }
+};
+
+template <typename Signal>
+void testParallelSkipsDisconnected()
+{
+  InlineExecutor executor;
+  Signal s;
+
+  // The first slot is in the chunk run first and disconnects the last one.
+  std::vector<int> called;
+  sigs::Connection last;
+  s.connect([&] {
+    called.push_back(0);
+    last->disconnect();
+  });
+  s.connect([&] { called.push_back(1); });
+  s.connect([&] { called.push_back(2); });
+  last = s.connect([&] { called.push_back(3); });
+
+  s.emitParallel(executor);
+  EXPECT_EQ(called, (std::vector<int>{0, 1, 2}));
+  EXPECT_EQ(s.size(), 3);
+}
+
+} // namespace
+
+TEST(Emission, parallelSkipsDisconnected)
+{
+  testParallelSkipsDisconnected<sigs::Signal<void()>>();
+  testParallelSkipsDisconnected<sigs::SharedSignal<void()>>();
+  testParallelSkipsDisconnected<sigs::EpochSignal<void()>>();
+}
+
+TEST(Emission, queued)
+{
+  sigs::EventLoop loop;
+  sigs::Signal<void(const std::string &, int &)> s;
+
+  std::vector<std::string> received;
+  int direct = 0;
+  s.connect(loop, [&received](const std::string &str, int &i) {
+    received.push_back(str);
+    i++;
+  });
+  s.connect([&direct](const std::string & /*unused*/, int &i) {
+    direct++;
+    i++;
+  });
+
+  int i = 0;
+  s("a", i);
+  s("b", i);
+
+  // Only the direct slot ran, and the queued slot gets copies of the arguments.
+  EXPECT_EQ(i, 2);
+  EXPECT_EQ(direct, 2);
+  EXPECT_TRUE(received.empty());
+
+  EXPECT_EQ(loop.drain(), 2);
+  EXPECT_EQ(received, (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(i, 2);
+  EXPECT_EQ(loop.drain(), 0);
+}
+
+TEST(Emission, queuedPoolExhausted)
+{
+  sigs::EventLoop loop;
+  sigs::Signal<void(int)> s;
+
+  int sum = 0;
+  s.connect(loop, [&sum](int value) { sum += value; }, 2);
+  for (int n = 1; n <= 5; ++n) {
+    s(static_cast<int>(n));
+  }
+  EXPECT_EQ(loop.drain(3), 3);
+  EXPECT_EQ(sum, 1 + 2 + 3);
+  EXPECT_EQ(loop.drain(), 2);
+  EXPECT_EQ(sum, 15);
+}
+
+TEST(Emission, queuedDeliveredAfterDisconnect)
+{
+  auto ptr = std::make_shared<int>(0);
+  sigs::EventLoop loop;
+  {
+    sigs::Signal<void()> s;
+    auto conn = s.connect(loop, [ptr] { (*ptr)++; });
+    s();
+    conn->disconnect();
+    s();
+  }
+
+  EXPECT_EQ(loop.drain(), 1);
+  EXPECT_EQ(*ptr, 1);
+  EXPECT_EQ(ptr.use_count(), 1);
+}
+
+TEST(Emission, queuedFromThreads)
+{
+  std::atomic_int wakeups = 0;
+  sigs::EventLoop loop([&wakeups] { wakeups++; });
+  sigs::Signal<void(int)> s;
+
+  int sum = 0;
+  s.connect(loop, [&sum](int value) { sum += value; }, 16);
+
+  std::atomic_bool done = false;
+  auto emit = [&] {
+    for (int n = 0; n < 1000; ++n) {
+      s(1);
+    }
+  };
+  std::thread t1(emit);
+  std::thread t2(emit);
+  std::thread consumer([&] {
+    while (!done) {
+      loop.drain();
+    }
+    loop.drain();
+  });
+  t1.join();
+  t2.join();
+  done = true;
+  consumer.join();
+
+  EXPECT_EQ(sum, 2000);
+  EXPECT_EQ(wakeups, 2000);
+}
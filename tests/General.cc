@@ -1,7 +1,10 @@
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -45,6 +48,50 @@ TEST(General, multipleFunctions)
   EXPECT_EQ(i, 3);
 }
 
+inline void addTwo(int &i)
+{
+  i += 2;
+}
+
+TEST(General, mixedFunctionsKeepOrder)
+{
+  int calls = 0;
+  sigs::Signal<void(std::string &)> s;
+  s.connect([](std::string &str) { str += "a"; });
+  s.connect([&calls](std::string &str) {
+    calls++;
+    str += "b";
+  });
+  s.connect([](std::string &str) { str += "c"; });
+  s.connect([](std::string &str) { str += "d"; });
+
+  decltype(s) s2;
+  s2.connect([](std::string &str) { str += "e"; });
+  s.connect(s2);
+  s.connect([](std::string &str) { str += "f"; });
+
+  std::string res;
+  s(res);
+  EXPECT_EQ(res, "abcdef");
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(General, disconnectFunctions)
+{
+  sigs::Signal<void(int &)> s;
+  s.connect(addOne);
+  auto conn = s.connect(addTwo);
+  s.connect([](int &i) { i += 4; });
+
+  int i = 0;
+  s(i);
+  EXPECT_EQ(i, 1 + 2 + 4);
+
+  conn->disconnect();
+  s(i);
+  EXPECT_EQ(i, (1 + 2 + 4) + (1 + 4));
+}
+
 TEST(General, functor)
 {
   class AddOneFunctor {
@@ -85,6 +132,60 @@ TEST(General, instanceMethod)
   EXPECT_EQ(i, 1);
 }
 
+TEST(General, instanceMethodCompileTime)
+{
+  class Foo {
+  public:
+    void test(int &i) const
+    {
+      i++;
+    }
+  };
+
+  sigs::Signal<void(int &)> s;
+
+  Foo foo;
+  s.connect<&Foo::test>(&foo);
+
+  int i = 0;
+  s(i);
+
+  EXPECT_EQ(i, 1);
+}
+
+TEST(General, virtualInstanceMethod)
+{
+  class Base {
+  public:
+    virtual ~Base() = default;
+
+    virtual void test(int &i)
+    {
+      i++;
+    }
+  };
+
+  class Derived : public Base {
+  public:
+    void test(int &i) override
+    {
+      i += 2;
+    }
+  };
+
+  sigs::Signal<void(int &)> s;
+
+  Derived derived;
+  Base *base = &derived;
+  s.connect(base, &Base::test);
+  s.connect<&Base::test>(base);
+
+  int i = 0;
+  s(i);
+
+  EXPECT_EQ(i, 4);
+}
+
 TEST(General, lambda)
 {
   sigs::Signal<void(int &)> s;
@@ -95,6 +196,43 @@ TEST(General, lambda)
   EXPECT_EQ(i, 1);
 }
 
+TEST(General, connectAll)
+{
+  sigs::Signal<void(std::vector<int> &)> s;
+  s.connect([](std::vector<int> &v) { v.push_back(0); });
+
+  std::vector<std::function<void(std::vector<int> &)>> funcs;
+  for (int i = 1; i <= 3; ++i) {
+    funcs.emplace_back([i](std::vector<int> &v) { v.push_back(i); });
+  }
+  auto conns = s.connectAll(funcs);
+  ASSERT_EQ(conns.size(), 3);
+  EXPECT_EQ(s.size(), 4);
+
+  conns[1]->disconnect();
+
+  std::vector<int> v;
+  s(v);
+  EXPECT_EQ(v, (std::vector<int>{0, 1, 3}));
+}
+
+TEST(General, connectAllFunctions)
+{
+  sigs::Signal<void(int &)> s;
+
+  const std::vector<void (*)(int &)> funcs{[](int &i) { i++; }, [](int &i) { i += 10; }};
+  auto conns = s.connectAll(funcs);
+  ASSERT_EQ(conns.size(), 2);
+
+  int i = 0;
+  s(i);
+  EXPECT_EQ(i, 11);
+
+  conns[0]->disconnect();
+  s(i);
+  EXPECT_EQ(i, 21);
+}
+
 TEST(General, connectionDisconnectDirectly)
 {
   sigs::Signal<void(int &)> s;
@@ -125,6 +263,41 @@ TEST(General, connectionDisconnectOnSignal)
   EXPECT_EQ(i, 1);
 }
 
+TEST(General, connectionCopies)
+{
+  static_assert(sizeof(sigs::Connection) == sizeof(void *));
+
+  sigs::Connection empty;
+  EXPECT_FALSE(empty);
+  EXPECT_EQ(empty, nullptr);
+
+  sigs::Signal<void()> s;
+  auto conn = s.connect([] {});
+  auto copy = conn;
+  EXPECT_TRUE(copy);
+  EXPECT_EQ(copy, conn);
+  EXPECT_NE(copy, s.connect([] {}));
+
+  copy->disconnect();
+  EXPECT_EQ(s.size(), 1);
+
+  // Disconnecting again, through any handle, has no effect.
+  conn->disconnect();
+  copy = nullptr;
+  conn->disconnect();
+  EXPECT_EQ(s.size(), 1);
+}
+
+TEST(General, connectionOutlivesSignal)
+{
+  sigs::Connection conn;
+  {
+    sigs::Signal<void()> s;
+    conn = s.connect([] {});
+  }
+  conn->disconnect();
+}
+
 TEST(General, specificConnectionDisconnectOnSignal)
 {
   sigs::Signal<void(int &)> s;
@@ -170,6 +343,39 @@ TEST(General, disconnectSignalFromSignal)
   EXPECT_EQ(i, 0);
 }
 
+// A connection closing a cycle is rejected, also from within a slot of a signal in the cycle.
+TEST(General, connectSignalCycle)
+{
+  sigs::Signal<void()> s1, s2, s3;
+  EXPECT_TRUE(s1.connect(s2));
+  EXPECT_TRUE(s2.connect(s3));
+  EXPECT_FALSE(s3.connect(s1));
+
+  sigs::Connection conn;
+  s3.connect([&] { conn = s3.connect(s1); });
+  s1();
+  EXPECT_FALSE(conn);
+  EXPECT_EQ(s3.size(), 1);
+}
+
+// Threads connecting two signals to each other at the same time never both succeed.
+TEST(General, connectSignalCycleConcurrently)
+{
+  sigs::Signal<void()> s1, s2;
+
+  for (int n = 0; n < 100; ++n) {
+    sigs::Connection conn1, conn2;
+    std::thread t1([&] { conn1 = s1.connect(s2); });
+    std::thread t2([&] { conn2 = s2.connect(s1); });
+    t1.join();
+    t2.join();
+    ASSERT_NE(static_cast<bool>(conn1), static_cast<bool>(conn2));
+
+    s1.clear();
+    s2.clear();
+  }
+}
+
 // Check for debug assertion.
 #ifndef NDEBUG
 TEST(General, disconnectSignalFromSelf)
@@ -179,6 +385,14 @@ TEST(General, disconnectSignalFromSelf)
 }
 #endif
 
+#ifndef NDEBUG
+TEST(General, connectSignalToSelf)
+{
+  sigs::Signal<void()> s;
+  EXPECT_DEATH(s.connect(s), "Connecting to self would emit recursively.");
+}
+#endif
+
 TEST(General, ambiguousMembers)
 {
   class Ambiguous {
@@ -223,6 +437,21 @@ TEST(General, returnValues)
   EXPECT_EQ(sum, 1 + 2 + 3);
 }
 
+TEST(General, returnValuesMixed)
+{
+  sigs::Signal<int()> s;
+  s.connect([] { return 1; });
+
+  int two = 2;
+  s.connect([&two] { return two; });
+  s.connect([] { return 3; });
+
+  std::vector<int> values;
+  s([&values](int retVal) { values.push_back(retVal); });
+
+  EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
+}
+
 TEST(General, returnValuesWithSignals)
 {
   sigs::Signal<int()> s, s2, s3;
@@ -251,6 +480,167 @@ TEST(General, returnValuesBlocked)
   EXPECT_EQ(sum, 0);
 }
 
+TEST(General, combiners)
+{
+  sigs::Signal<int(int)> s;
+  s.connect([](int i) { return i; });
+  s.connect([](int i) { return i * 3; });
+  s.connect([](int i) { return i * 2; });
+
+  EXPECT_EQ(s.emit<sigs::collect::Sum>(1), 1 + 3 + 2);
+  EXPECT_EQ(s.emit<sigs::collect::Max>(1), 3);
+  EXPECT_EQ(s.emit<sigs::collect::Last>(1), 2);
+  EXPECT_EQ(s.emit<sigs::collect::ToVector>(1), (std::vector<int>{1, 3, 2}));
+  EXPECT_EQ(s.emit(sigs::collect::Sum<int>(), 2), 2 + 6 + 4);
+}
+
+TEST(General, combinersWithoutSlots)
+{
+  sigs::Signal<int()> s;
+  EXPECT_EQ(s.emit<sigs::collect::Sum>(), 0);
+  EXPECT_FALSE(s.emit<sigs::collect::Max>());
+  EXPECT_FALSE(s.emit<sigs::collect::Last>());
+  EXPECT_TRUE(s.emit<sigs::collect::ToVector>().empty());
+
+  s.connect([] { return 1; });
+  s.setBlocked(true);
+  EXPECT_EQ(s.emit<sigs::collect::Sum>(), 0);
+}
+
+TEST(General, combinerFirstNonNull)
+{
+  int a = 1, b = 2;
+  sigs::Signal<int *()> s;
+  s.connect([]() -> int * { return nullptr; });
+  s.connect([&a] { return &a; });
+  s.connect([&b] { return &b; });
+  EXPECT_EQ(s.emit<sigs::collect::FirstNonNull>(), &a);
+
+  sigs::Signal<int *()> s2;
+  s2.connect([]() -> int * { return nullptr; });
+  EXPECT_EQ(s2.emit<sigs::collect::FirstNonNull>(), nullptr);
+}
+
+TEST(General, combinerWithSignals)
+{
+  sigs::Signal<int()> s, s2;
+  s2.connect([] { return 2; });
+  s2.connect([] { return 3; });
+  s.connect([] { return 1; });
+  s.connect(s2);
+  s.connect([] { return 4; });
+
+  EXPECT_EQ(s.emit<sigs::collect::ToVector>(), (std::vector<int>{1, 2, 3, 4}));
+}
+
+inline bool isPositive(int i)
+{
+  return i > 0;
+}
+
+TEST(General, shortCircuit)
+{
+  std::vector<int> calls;
+  sigs::Signal<bool(int)> s;
+  s.connect(isPositive);
+  s.connect([&calls](int i) {
+    calls.push_back(1);
+    return i > 1;
+  });
+  s.connect([&calls](int i) {
+    calls.push_back(2);
+    return i > 2;
+  });
+
+  EXPECT_FALSE(s.emit<sigs::collect::AnyOf>(0));
+  EXPECT_EQ(calls, (std::vector<int>{1, 2}));
+
+  calls.clear();
+  EXPECT_TRUE(s.emit<sigs::collect::AnyOf>(1));
+  EXPECT_TRUE(calls.empty());
+
+  calls.clear();
+  EXPECT_TRUE(s.emit<sigs::collect::AllOf>(3));
+  EXPECT_EQ(calls, (std::vector<int>{1, 2}));
+
+  calls.clear();
+  EXPECT_FALSE(s.emit<sigs::collect::AllOf>(1));
+  EXPECT_EQ(calls, (std::vector<int>{1}));
+}
+
+TEST(General, combinersAccumulate)
+{
+  // The results don't depend on emissions stopping once done() is true.
+  sigs::collect::AnyOf<bool> any;
+  any(true);
+  any(false);
+  EXPECT_TRUE(any.result());
+
+  sigs::collect::AllOf<bool> all;
+  all(false);
+  all(true);
+  EXPECT_FALSE(all.result());
+}
+
+TEST(General, shortCircuitWithSignals)
+{
+  std::vector<int> calls;
+  sigs::Signal<bool()> s, s2;
+  s.connect([&calls] {
+    calls.push_back(1);
+    return false;
+  });
+  s.connect(s2);
+  s.connect([&calls] {
+    calls.push_back(4);
+    return true;
+  });
+  s2.connect([&calls] {
+    calls.push_back(2);
+    return true;
+  });
+  s2.connect([&calls] {
+    calls.push_back(3);
+    return true;
+  });
+
+  EXPECT_TRUE(s.emit<sigs::collect::AnyOf>());
+  EXPECT_EQ(calls, (std::vector<int>{1, 2}));
+}
+
+TEST(General, customCombiner)
+{
+  class Count final {
+  public:
+    void reserve(std::size_t count)
+    {
+      reserved = count;
+    }
+
+    void operator()(bool value)
+    {
+      trues += value ? 1 : 0;
+    }
+
+    [[nodiscard]] std::pair<std::size_t, std::size_t> result() const
+    {
+      return {reserved, trues};
+    }
+
+  private:
+    std::size_t reserved = 0, trues = 0;
+  };
+
+  sigs::Signal<bool(int)> s;
+  s.connect([](int i) { return i > 0; });
+  s.connect([](int i) { return i > 1; });
+  s.connect([](int i) { return i > 2; });
+
+  const auto [reserved, trues] = s.emit(Count(), 2);
+  EXPECT_EQ(reserved, 3);
+  EXPECT_EQ(trues, 2);
+}
+
 TEST(General, sameSlotManyConnections)
 {
   int calls = 0;
@@ -338,6 +728,65 @@ TEST(General, disconnectWithNoSlotClearsAll)
   ASSERT_TRUE(s.empty());
 }
 
+TEST(General, disconnectManyKeepsOrder)
+{
+  std::vector<int> calls;
+  sigs::Signal<void()> s;
+  std::vector<sigs::Connection> conns;
+  for (int i = 0; i < 10; ++i) {
+    conns.emplace_back(s.connect([&calls, i] { calls.push_back(i); }));
+  }
+
+  // Erases a few entries at a time, so some are compacted and some are left empty.
+  for (const int i : {1, 8, 3}) {
+    conns[i]->disconnect();
+  }
+  s();
+  EXPECT_EQ(calls, (std::vector<int>{0, 2, 4, 5, 6, 7, 9}));
+  EXPECT_EQ(s.size(), 7);
+
+  for (const int i : {4, 0, 9}) {
+    conns[i]->disconnect();
+  }
+  s.connect([&calls] { calls.push_back(10); });
+  calls.clear();
+  s();
+  EXPECT_EQ(calls, (std::vector<int>{2, 5, 6, 7, 10}));
+  EXPECT_EQ(s.size(), 5);
+
+  // Disconnecting again has no effect.
+  s.disconnect(conns[4]);
+  EXPECT_EQ(s.size(), 5);
+}
+
+TEST(General, disconnectStaleConnection)
+{
+  int calls = 0;
+  sigs::Signal<void()> s;
+  auto conn = s.connect([&calls] { calls++; });
+  s.disconnect(conn);
+
+  // Takes the place of the first connection, which must not disconnect it.
+  auto conn2 = s.connect([&calls] { calls++; });
+  s.disconnect(conn);
+  s();
+  EXPECT_EQ(calls, 1);
+
+  conn2->disconnect();
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(General, disconnectConnectionOfOtherSignal)
+{
+  sigs::Signal<void()> s, s2;
+  s.connect([] {});
+  auto conn = s2.connect([] {});
+
+  s.disconnect(conn);
+  EXPECT_EQ(s.size(), 1);
+  EXPECT_EQ(s2.size(), 1);
+}
+
 TEST(General, blocked)
 {
   sigs::Signal<void()> s;
@@ -77,6 +77,27 @@ TEST(Interface, instanceMethod)
   EXPECT_EQ(i, 1);
 }
 
+TEST(Interface, instanceMethodCompileTime)
+{
+  class Foo {
+  public:
+    void test(int &i) const
+    {
+      i++;
+    }
+  };
+
+  sigs::Signal<void(int &)> s;
+
+  Foo foo;
+  s.interface()->connect<&Foo::test>(&foo);
+
+  int i = 0;
+  s(i);
+
+  EXPECT_EQ(i, 1);
+}
+
 TEST(Interface, lambda)
 {
   sigs::Signal<void(int &)> s;
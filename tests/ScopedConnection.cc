@@ -0,0 +1,131 @@
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+TEST(ScopedConnection, disconnectsWhenDestroyed)
+{
+  static_assert(sizeof(sigs::ScopedConnection) == sizeof(sigs::Connection));
+  static_assert(!std::is_copy_constructible_v<sigs::ScopedConnection>);
+
+  int calls = 0;
+  sigs::Signal<void()> s;
+  {
+    sigs::ScopedConnection conn = s.connect([&calls] { calls++; });
+    EXPECT_TRUE(conn);
+    s();
+  }
+  s();
+  EXPECT_EQ(calls, 1);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(ScopedConnection, move)
+{
+  sigs::Signal<void()> s;
+  sigs::ScopedConnection conn = s.connect([] {});
+  {
+    auto moved = std::move(conn);
+    EXPECT_FALSE(conn);
+    EXPECT_EQ(s.size(), 1);
+  }
+  EXPECT_TRUE(s.empty());
+
+  // Assigning disconnects the previous connection.
+  conn = s.connect([] {});
+  conn = s.connect([] {});
+  EXPECT_EQ(s.size(), 1);
+}
+
+TEST(ScopedConnection, release)
+{
+  sigs::Signal<void()> s;
+  sigs::Connection released;
+  {
+    sigs::ScopedConnection conn = s.connect([] {});
+    released = conn.release();
+    EXPECT_FALSE(conn);
+  }
+  EXPECT_EQ(s.size(), 1);
+
+  released->disconnect();
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(ScopedConnection, outlivesSignal)
+{
+  sigs::ScopedConnection conn;
+  {
+    sigs::Signal<void()> s;
+    conn = s.connect([] {});
+  }
+  conn.disconnect();
+  EXPECT_FALSE(conn);
+}
+
+TEST(ConnectionSet, disconnectsWhenDestroyed)
+{
+  std::vector<int> calls;
+  sigs::Signal<void()> s, s2;
+  s.connect([&calls] { calls.push_back(0); });
+  {
+    sigs::ConnectionSet set;
+    for (int i = 1; i <= 3; ++i) {
+      set += s.connect([&calls, i] { calls.push_back(i); });
+      set.add(s2.connect([] {}));
+    }
+    s.connect([&calls] { calls.push_back(4); });
+    EXPECT_EQ(set.size(), 6);
+  }
+
+  s();
+  EXPECT_EQ(calls, (std::vector<int>{0, 4}));
+  EXPECT_TRUE(s2.empty());
+}
+
+TEST(ConnectionSet, disconnect)
+{
+  sigs::Signal<void()> s;
+  sigs::ConnectionSet set;
+  set += s.connect([] {});
+
+  // Connections disconnected otherwise are ignored.
+  auto conn = s.connect([] {});
+  set += conn;
+  conn->disconnect();
+
+  set.disconnect();
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(ConnectionSet, epochSignal)
+{
+  int calls = 0;
+  sigs::EpochSignal<void()> s;
+  sigs::ConnectionSet set;
+  for (int i = 0; i < 100; ++i) {
+    set += s.connect([&calls] { calls++; });
+  }
+  s.connect([&calls] { calls += 1000; });
+
+  set.disconnect();
+  s();
+  EXPECT_EQ(calls, 1000);
+}
+
+TEST(ConnectionSet, outlivesSignal)
+{
+  sigs::ConnectionSet set;
+  sigs::Signal<void()> s;
+  set += s.connect([] {});
+  {
+    sigs::Signal<void()> s2;
+    set += s2.connect([] {});
+  }
+  set.disconnect();
+  EXPECT_TRUE(s.empty());
+}
@@ -0,0 +1,150 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+// Neither a mutex for the entries nor one for deferred modifications.
+static_assert(sizeof(sigs::SignalST<void()>) < sizeof(sigs::Signal<void()>));
+
+TEST(SignalST, emit)
+{
+  sigs::SignalST<int(int)> s;
+  int calls = 0;
+  const auto conn = s.connect([&calls](int i) {
+    calls++;
+    return i * 2;
+  });
+  s.connect([](int i) { return i * 3; });
+
+  s(1);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(s.emit<sigs::collect::Sum>(2), 10);
+  EXPECT_EQ(s.size(), 2);
+
+  s.disconnect(conn);
+  EXPECT_EQ(s.size(), 1);
+  s.clear();
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(SignalST, blocked)
+{
+  sigs::SignalST<void()> s;
+  int calls = 0;
+  s.connect([&calls] { calls++; });
+
+  {
+    sigs::SignalBlocker blocker(s);
+    s();
+  }
+  EXPECT_EQ(calls, 0);
+
+  EXPECT_FALSE(s.setBlocked(true));
+  EXPECT_TRUE(s.blocked());
+  s.setBlocked(false);
+  s();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(SignalST, connections)
+{
+  sigs::Connection copy;
+  {
+    sigs::SignalST<void()> s;
+    auto conn = s.connect([] {});
+    copy = conn;
+    sigs::Connection moved(std::move(conn));
+    EXPECT_EQ(copy, moved);
+
+    sigs::ScopedConnection scoped = s.connect([] {});
+    EXPECT_EQ(s.size(), 2);
+  }
+
+  // Outlives the signal.
+  copy->disconnect();
+}
+
+TEST(SignalST, modifyFromSlot)
+{
+  sigs::SignalST<void()> s;
+  int calls = 0, added = 0;
+  sigs::Connection conn;
+  conn = s.connect([&] {
+    calls++;
+    conn->disconnect();
+    s.connect([&added] { added++; });
+  });
+
+  // Deferred until the emission exits.
+  s();
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(added, 0);
+  EXPECT_EQ(s.size(), 1);
+
+  s();
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(added, 1);
+}
+
+TEST(SignalST, nestedEmission)
+{
+  sigs::SignalST<void(int)> s;
+  std::vector<int> calls;
+  s.connect([&](int i) {
+    calls.push_back(i);
+    if (i > 0) {
+      s(i - 1);
+      s.clear();
+    }
+  });
+
+  s(2);
+  EXPECT_EQ(calls, (std::vector<int>{2, 1, 0}));
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(SignalST, chainedSignals)
+{
+  sigs::SignalST<void(int)> s, s2;
+  int sum = 0;
+  s.connect(s2);
+  s2.connect([&sum](int i) { sum += i; });
+
+  s(2);
+  s(3);
+  EXPECT_EQ(sum, 5);
+}
+
+TEST(SignalST, handOver)
+{
+  // Constructing the signal doesn't use it, so another thread can take it over before its first
+  // use, and then also destroy it.
+  auto s = std::make_unique<sigs::SignalST<void()>>();
+  int calls = 0;
+  std::thread([&s, &calls] {
+    s->connect([&calls] { calls++; });
+    (*s)();
+    s.reset();
+  }).join();
+  EXPECT_EQ(calls, 1);
+}
+
+// Check for debug assertion.
+#ifndef NDEBUG
+TEST(SignalST, usedByAnotherThread)
+{
+  EXPECT_DEATH(
+    {
+      // The thread using the signal first owns it for good, even though the other thread only
+      // uses it after the owner is done with it.
+      sigs::SignalST<void()> s;
+      s.connect([] {});
+      s();
+      std::thread([&s] { s(); }).join();
+    },
+    "Single-threaded signal used by another thread.");
+}
+#endif
@@ -0,0 +1,89 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+TEST(SpinFutexMutex, tryLock)
+{
+  sigs::SpinFutexMutex mutex;
+  ASSERT_TRUE(mutex.try_lock());
+  EXPECT_FALSE(mutex.try_lock());
+  mutex.unlock();
+
+  {
+    sigs::SpinFutexLock lock(mutex);
+    EXPECT_FALSE(mutex.try_lock());
+  }
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(SpinFutexMutex, mutualExclusion)
+{
+  sigs::SpinFutexMutex mutex;
+  int counter = 0;
+
+  // More threads than cores, so some of them are parked while the lock is held.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 16; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 2000; ++i) {
+        std::scoped_lock lock(mutex);
+        counter++;
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter, 16 * 2000);
+}
+
+TEST(SpinFutexMutex, parkedUntilUnlocked)
+{
+  sigs::SpinFutexMutex mutex;
+  std::atomic_bool locked = false;
+
+  mutex.lock();
+  std::thread waiter([&] {
+    std::scoped_lock lock(mutex);
+    locked = true;
+  });
+
+  // The waiter marks the mutex as contended once it stops spinning, right before parking.
+  while (!mutex.contended()) {
+    std::this_thread::yield();
+  }
+  EXPECT_FALSE(locked);
+
+  mutex.unlock();
+  waiter.join();
+  EXPECT_TRUE(locked);
+}
+
+TEST(SpinFutexMutex, fastSignal)
+{
+  sigs::FastSignal<void(int &)> s;
+  s.connect([](int &i) { i++; });
+
+  std::atomic_bool done = false;
+  std::thread writer([&] {
+    for (int n = 0; n < 1000; ++n) {
+      auto conn = s.connect([](int & /*unused*/) {});
+      conn->disconnect();
+    }
+    done = true;
+  });
+
+  while (!done) {
+    int i = 0;
+    s(i);
+    ASSERT_EQ(i, 1);
+  }
+  writer.join();
+  EXPECT_EQ(s.size(), 1);
+}
@@ -0,0 +1,137 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+namespace {
+
+void addOne(int &i)
+{
+  i++;
+}
+
+void addTwo(int &i)
+{
+  i += 2;
+}
+
+int one()
+{
+  return 1;
+}
+
+int two()
+{
+  return 2;
+}
+
+int rejections = 0;
+
+bool reject()
+{
+  rejections++;
+  return false;
+}
+
+constexpr auto addFour = [](int &i) { i += 4; };
+
+} // namespace
+
+TEST(StaticSignal, instantiate)
+{
+  sigs::StaticSignal<void()> s;
+  EXPECT_TRUE(s.empty());
+  s();
+
+  sigs::StaticSignal<void(int &), &addOne, &addTwo> s2;
+  static_assert(decltype(s2)::size() == 2);
+}
+
+TEST(StaticSignal, functions)
+{
+  sigs::StaticSignal<void(int &), &addOne, &addTwo> s;
+
+  int i = 0;
+  s(i);
+  EXPECT_EQ(i, 3);
+}
+
+TEST(StaticSignal, lambdas)
+{
+  sigs::StaticSignal<void(int &), addFour, &addOne> s;
+
+  int i = 0;
+  s(i);
+  EXPECT_EQ(i, 5);
+}
+
+TEST(StaticSignal, order)
+{
+  static std::string res;
+  res.clear();
+
+  sigs::StaticSignal<void(const std::string &), [](const std::string &str) { res += str + "1"; },
+                     [](const std::string &str) { res += str + "2"; }>
+    s;
+  s("x");
+  EXPECT_EQ(res, "x1x2");
+}
+
+TEST(StaticSignal, returnValues)
+{
+  sigs::StaticSignal<int(), &one, &two> s;
+
+  int sum = 0;
+  s([&sum](int retVal) { sum += retVal; });
+  EXPECT_EQ(sum, 1 + 2);
+}
+
+TEST(StaticSignal, combiners)
+{
+  sigs::StaticSignal<int(), &one, &two> s;
+  EXPECT_EQ(s.emit<sigs::collect::Sum>(), 1 + 2);
+  EXPECT_EQ(s.emit<sigs::collect::ToVector>(), (std::vector<int>{1, 2}));
+
+  s.setBlocked(true);
+  EXPECT_EQ(s.emit<sigs::collect::Sum>(), 0);
+}
+
+TEST(StaticSignal, shortCircuit)
+{
+  sigs::StaticSignal<int(), &one, &two> s;
+  EXPECT_EQ(s.emit<sigs::collect::FirstNonNull>(), 1);
+
+  sigs::StaticSignal<bool(), &reject, &reject> s2;
+  EXPECT_FALSE(s2.emit<sigs::collect::AllOf>());
+  EXPECT_EQ(rejections, 1);
+}
+
+TEST(StaticSignal, blocked)
+{
+  sigs::StaticSignal<int(), &one, &two> s;
+  ASSERT_FALSE(s.setBlocked(true));
+  ASSERT_TRUE(s.blocked());
+
+  int sum = 0;
+  s([&sum](int retVal) { sum += retVal; });
+  EXPECT_EQ(sum, 0);
+}
+
+TEST(StaticSignal, signalBlocker)
+{
+  sigs::StaticSignal<void(int &), &addOne> s;
+
+  int i = 0;
+  {
+    sigs::SignalBlocker blocker(s);
+    ASSERT_TRUE(s.blocked());
+    s(i);
+    EXPECT_EQ(i, 0);
+  }
+
+  ASSERT_FALSE(s.blocked());
+  s(i);
+  EXPECT_EQ(i, 1);
+}
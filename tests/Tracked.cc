@@ -0,0 +1,198 @@
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sigs.h"
+
+namespace {
+
+class Counter {
+public:
+  void add(int i)
+  {
+    value += i;
+  }
+
+  int get() const
+  {
+    return value;
+  }
+
+  int value = 0;
+};
+
+} // namespace
+
+TEST(Tracked, memberFunction)
+{
+  sigs::Signal<void(int)> s;
+  auto counter = std::make_shared<Counter>();
+  s.connect(std::weak_ptr(counter), &Counter::add);
+
+  s(2);
+  s(3);
+  EXPECT_EQ(counter->value, 5);
+
+  counter.reset();
+  s(4);
+
+  // Erased by the next modification.
+  EXPECT_EQ(s.size(), 1);
+  const auto conn = s.connect([](int /*unused*/) {});
+  EXPECT_EQ(s.size(), 1);
+  s.disconnect(conn);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Tracked, slot)
+{
+  sigs::Signal<void()> s;
+  auto owner = std::make_shared<int>(0);
+  int calls = 0;
+  s.connect(std::weak_ptr(owner), [&calls] { calls++; });
+
+  s();
+  owner.reset();
+  s();
+  EXPECT_EQ(calls, 1);
+
+  s.clear();
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Tracked, alreadyExpired)
+{
+  sigs::Signal<void(int)> s;
+  std::weak_ptr<Counter> gone;
+  {
+    auto counter = std::make_shared<Counter>();
+    gone = counter;
+  }
+  s.connect(gone, &Counter::add);
+  s(1);
+
+  const auto conn = s.connect([](int /*unused*/) {});
+  EXPECT_EQ(s.size(), 1);
+  s.disconnect(conn);
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(Tracked, onlyFlaggedByEmission)
+{
+  sigs::Signal<void()> s;
+  auto owner = std::make_shared<int>(0);
+  s.connect(std::weak_ptr(owner), [] {});
+  owner.reset();
+
+  // Not erased until an emission came across it.
+  s.connect([] {});
+  EXPECT_EQ(s.size(), 2);
+
+  s();
+  s.connect([] {});
+  EXPECT_EQ(s.size(), 2);
+}
+
+TEST(Tracked, keptAliveDuringCall)
+{
+  sigs::Signal<void()> s;
+  auto counter = std::make_shared<Counter>();
+  std::weak_ptr<Counter> observer = counter;
+  bool alive = false;
+  s.connect(observer, [&] {
+    counter.reset();
+    alive = !observer.expired();
+  });
+
+  s();
+  EXPECT_TRUE(alive);
+  EXPECT_TRUE(observer.expired());
+}
+
+TEST(Tracked, returnValuesSkipped)
+{
+  sigs::Signal<int()> s;
+  auto first = std::make_shared<Counter>();
+  auto second = std::make_shared<Counter>();
+  first->value = 1;
+  second->value = 2;
+  s.connect(std::weak_ptr(first), &Counter::get);
+  s.connect(std::weak_ptr(second), &Counter::get);
+
+  EXPECT_EQ(s.emit<sigs::collect::Sum>(), 3);
+
+  first.reset();
+  EXPECT_EQ(s.emit(sigs::collect::ToVector<int>()), std::vector<int>{2});
+}
+
+TEST(Tracked, interface)
+{
+  sigs::Signal<void(int)> s;
+  auto counter = std::make_shared<Counter>();
+  int calls = 0;
+  s.interface()->connect(std::weak_ptr(counter), &Counter::add);
+  s.interface()->connect(std::weak_ptr(counter), [&calls](int /*unused*/) { calls++; });
+
+  s(2);
+  EXPECT_EQ(counter->value, 2);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(Tracked, batch)
+{
+  sigs::Signal<void(int)> s;
+  auto counter = std::make_shared<Counter>();
+  s.connect(std::weak_ptr(counter), &Counter::add);
+
+  const std::vector<std::tuple<int>> events{{1}, {2}, {3}};
+  s.emitBatch(events, sigs::BatchOrder::EventMajor);
+  s.emitBatch(events, sigs::BatchOrder::SlotMajor);
+  EXPECT_EQ(counter->value, 12);
+
+  counter.reset();
+  s.emitBatch(events);
+  s.connect([](int /*unused*/) {});
+  EXPECT_EQ(s.size(), 1);
+}
+
+namespace {
+
+template <typename Signal>
+void chainedSignals()
+{
+  Signal s, s2;
+  auto counter = std::make_shared<Counter>();
+  s.connect(s2);
+  s2.connect(std::weak_ptr(counter), &Counter::add);
+
+  s(2);
+  EXPECT_EQ(counter->value, 2);
+
+  counter.reset();
+  s(3);
+  EXPECT_EQ(s2.size(), 1);
+
+  // Flagged on the entries of the connected signal, which erases it when modified.
+  s2.connect([](int /*unused*/) {});
+  EXPECT_EQ(s2.size(), 1);
+  EXPECT_EQ(s.size(), 1);
+}
+
+} // namespace
+
+TEST(Tracked, chainedSignals)
+{
+  chainedSignals<sigs::Signal<void(int)>>();
+}
+
+TEST(Tracked, snapshotChainedSignals)
+{
+  chainedSignals<sigs::SnapshotSignal<void(int)>>();
+}
+
+TEST(Tracked, epochChainedSignals)
+{
+  chainedSignals<sigs::EpochSignal<void(int)>>();
+}